@@ -7,24 +7,91 @@
 #ifndef _AVRHAL_DISPLAY__H__
 #define _AVRHAL_DISPLAY__H__
 
+#include <stdbool.h>
 #include <stdint.h>
 
 #include "bitmap.h"
 
 #define DISPLAY_DEFAULT_CONTRAST 128
-#define DISPLAY_WIDTH 128
-#define DISPLAY_HEIGHT 64
+
+/* Several panels can be placed side by side, each on its own chip select line (see displaybackend.h).
+ * They form one logical framebuffer of DISPLAY_WIDTH columns. Every panel needs 1 KB of framebuffer,
+ * so more than one panel requires a part with more SRAM than the ATmega32 (e.g. ATmega644/1284). */
+#ifndef DISPLAY_PANELS
+#define DISPLAY_PANELS 1
+#endif
+#if DISPLAY_PANELS > 2
+#error "Coordinates are 8 bit, at most two panels are supported"
+#endif
+#define DISPLAY_PANEL_WIDTH 128
 #define DISPLAY_PAGES 8
 #define DISPLAY_BITS_PER_PAGE_COLUMN 8
 
+/* Physical framebuffer size: one 64 bit column per segment of all panels */
+#define DISPLAY_COLUMNS (DISPLAY_PANEL_WIDTH * DISPLAY_PANELS)
+#define DISPLAY_ROWS (DISPLAY_PAGES * DISPLAY_BITS_PER_PAGE_COLUMN)
+
+/* Orientation of the panel in degrees (0, 90, 180 or 270), counter-clockwise.
+ * 90 means the left edge of the panel is at the bottom. Mirroring is done by the display controller,
+ * swapping the axes for 90 and 270 is resolved at compile time in the rasterizer. So the whole
+ * drawing API uses logical coordinates without any runtime cost. */
+#ifndef DISPLAY_ORIENTATION
+#define DISPLAY_ORIENTATION 0
+#endif
+#define DISPLAY_TRANSPOSED (DISPLAY_ORIENTATION == 90 || DISPLAY_ORIENTATION == 270)
+
+/* Logical display size, as seen by the viewer */
+#if DISPLAY_TRANSPOSED
+#define DISPLAY_WIDTH DISPLAY_ROWS
+#define DISPLAY_HEIGHT DISPLAY_COLUMNS
+#else
+#define DISPLAY_WIDTH DISPLAY_COLUMNS
+#define DISPLAY_HEIGHT DISPLAY_ROWS
+#endif
+
+/* Number of emulated gray levels including black and white. A level L is shown in L out of
+ * (DISPLAY_GRAY_LEVELS - 1) frames, so the flicker frequency is the refresh rate divided by that.
+ * 3 levels need at least 120 Hz, 4 levels 150+ Hz to look steady. */
+#ifndef DISPLAY_GRAY_LEVELS
+#define DISPLAY_GRAY_LEVELS 3
+#endif
+#define DISPLAY_GRAY_BLACK 0
+#define DISPLAY_GRAY_WHITE (DISPLAY_GRAY_LEVELS - 1)
+/** Frequency at which a gray pixel blinks when displayUpdate() runs at refreshRate */
+#define DISPLAY_GRAY_FLICKER_HZ(refreshRate) ((refreshRate) / (DISPLAY_GRAY_LEVELS - 1))
+/* Below this the blinking is clearly visible on an OLED, gray should not be used */
+#define DISPLAY_GRAY_MIN_FLICKER_HZ 60
+
 void displayReset();
 
 /** Carry out a display hardware initialization, including a hardware reset. */
 void displaySetup();
 void displayClearBuffer();
 
+/** @return the physical framebuffer (DISPLAY_COLUMNS columns of DISPLAY_ROWS bits), independent of the orientation.
+ * Only for reading: with several panels the drawing functions track which panels changed, direct writes are not seen. */
 uint64_t* displayFrameBuffer();
+/** Transfer the framebuffer. With several panels only the panels which were drawn on (or cleared) since the last frame are sent. */
 void displayUpdate();
+/** Only transfer the given part of the framebuffer. Pages and framebuffer columns are physical and inclusive,
+ * columns may span several panels. Panels which didn't change since the last frame are skipped. */
+void displayUpdateRegion(uint8_t firstPage, uint8_t lastPage, uint8_t firstColumn, uint8_t lastColumn);
+/** Only transfer the logical rows firstRow - lastRow (inclusive) over the whole display width.
+ * In portrait orientation these are exactly the framebuffer columns, otherwise whole pages are sent. */
+void displayUpdateRows(uint8_t firstRow, uint8_t lastRow);
+/** Finish a frame which was transferred in parts with displayUpdateRegion()/displayUpdateRows(),
+ * this advances the gray level dithering. The parts have to cover every change of the frame, afterwards
+ * all panels count as unchanged. displayUpdate() does this itself. */
+void displayEndFrame();
+
+/** Set the display brightness/contrast (value range 0 - 255). */
+void displaySetContrast(uint8_t contrast);
+void displaySetInverted(bool inverted);
+/** Map the first RAM data row to the given physical pixel row. */
+void displaySetStartLine(uint8_t line);
+
+/** Set the gray level (DISPLAY_GRAY_BLACK - DISPLAY_GRAY_WHITE) used by all following draw calls. */
+void displaySetGray(uint8_t level);
 
 void displayDrawVerticalLine(uint8_t x, uint8_t y, uint8_t length);
 void displayDrawHorizontalLine(uint8_t x, uint8_t y, uint8_t length);
@@ -33,10 +100,13 @@ void displayDrawLine(uint8_t x1, uint8_t y1, uint8_t x2, uint8_t y2);
 void displayDrawRectangle(uint8_t x, uint8_t y, uint8_t w, uint8_t h);
 void displayDrawFilledRectangle(uint8_t x, uint8_t y, uint8_t w, uint8_t h);
 void displayDrawPixel(uint8_t x, uint8_t y);
+bool displayGetPixel(uint8_t x, uint8_t y);
+/** OR a mask into the row y, bit i is the pixel in column i. A single store if the orientation is 90 or 270. */
+void displayDrawRowMask(uint8_t y, uint64_t mask);
+void displayDrawCircle(uint8_t xm, uint8_t ym, uint8_t r);
+void displayDrawFilledCircle(uint8_t xm, uint8_t ym, uint8_t r);
 void displayDrawBitmap(uint8_t x, uint8_t y, const Bitmap* bmp);
 void displayRenderText(uint8_t x, uint8_t y, const char* str);
-void displayRenderTextVertical(uint8_t x, uint8_t y, const char* str);
 void displayPrint(uint8_t x, uint8_t y, const char* format, ...);
-void displayPrintVertical(uint8_t x, uint8_t y, const char* format, ...);
 
 #endif
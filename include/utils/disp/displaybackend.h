@@ -0,0 +1,65 @@
+/**
+ * @brief Display controller backend interface
+ *
+ * display.c owns the framebuffer and the rasterizer, everything controller specific is
+ * implemented by a backend. Exactly one backend is linked, selected at build time:
+ * - SH1106 (default)
+ * - SSD1306 (build flag DISPLAY_BACKEND_SSD1306)
+ * As the functions are resolved by the linker, there is no runtime dispatch.
+ */
+
+#ifndef _AVRHAL_DISPLAYBACKEND__H__
+#define _AVRHAL_DISPLAYBACKEND__H__
+
+#include <avr/io.h>
+#include <stdbool.h>
+#include <stdint.h>
+
+/* Control lines on PORTB, in addition to the SPI pins */
+#define DISPLAY_RESET_PIN PB3
+#define DISPLAY_DATA_CMD_PIN PB4
+/* Chip select lines (active low) of the panels from left to right, only used with more than one panel.
+ * A single panel has its chip select tied to ground. */
+#define DISPLAY_CS_PINS {PB0, PB1}
+
+/* Mirroring needed for the configured orientation, applied by the backends with the segment remap
+ * (columns) and COM scan direction (rows) commands */
+#define DISPLAY_FLIP_COLUMNS (DISPLAY_ORIENTATION == 90 || DISPLAY_ORIENTATION == 180)
+#define DISPLAY_FLIP_ROWS (DISPLAY_ORIENTATION == 180 || DISPLAY_ORIENTATION == 270)
+
+/* Bus helpers, implemented in display.c and shared by all backends */
+
+/** Signal, that the following bytes are data. */
+void displaySetDataIndicator();
+/** Signal, that the following bytes are commands. */
+void displaySetCommandIndicator();
+/** Send a single-byte command. */
+void displaySendCommand(uint8_t cmd);
+/** Send a single data byte. */
+void displaySendData(uint8_t data);
+
+/* Backend interface */
+
+/** Configure the controller after the hardware reset. The display is left switched off. */
+void displayBackendInit();
+
+/** Transfer the framebuffer part of the currently selected panel into the display RAM.
+ *
+ * @param[in] frameBuffer first column of the panel
+ */
+void displayBackendFlush(const uint64_t* frameBuffer);
+
+/** Transfer a rectangular part of the framebuffer into the display RAM of the currently selected panel.
+ *
+ * @param[in] frameBuffer first column of the panel
+ * @param[in] firstPage, lastPage (inclusive, value between 0-7)
+ * @param[in] firstColumn, lastColumn (inclusive, value between 0-127)
+ */
+void displayBackendFlushRegion(const uint64_t* frameBuffer, uint8_t firstPage, uint8_t lastPage, uint8_t firstColumn, uint8_t lastColumn);
+
+void displayBackendSetPower(bool on);
+void displayBackendSetContrast(uint8_t contrast);
+void displayBackendSetInverted(bool inverted);
+void displayBackendSetStartLine(uint8_t line);
+
+#endif
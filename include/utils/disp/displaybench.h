@@ -0,0 +1,70 @@
+/**
+ * @brief Benchmark and regression check for the display primitives
+ *
+ * Every case draws one primitive into a cleared framebuffer, measures the duration with the
+ * profiler and compares a CRC16 of the resulting framebuffer against a golden value.
+ * Only available when PROFILE_ENABLED is defined. With DISPLAY_BENCH_REPORT the results can be
+ * sent as CSV over the USART, otherwise they have to be inspected with the debugger.
+ */
+
+#ifndef _AVRHAL_DISPLAYBENCH__H__
+#define _AVRHAL_DISPLAYBENCH__H__
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#define DISPLAY_BENCH_REPORT_BAUD 115200
+
+typedef enum {
+	DISPLAY_BENCH_LINE,
+	DISPLAY_BENCH_RECTANGLE,
+	DISPLAY_BENCH_FILLED_RECTANGLE,
+	DISPLAY_BENCH_CIRCLE,
+	DISPLAY_BENCH_FILLED_CIRCLE,
+	DISPLAY_BENCH_BITMAP,
+	DISPLAY_BENCH_TEXT
+} DisplayBenchPrimitive;
+
+typedef struct {
+	uint8_t primitive; /* DisplayBenchPrimitive */
+	uint8_t x;
+	uint8_t y;
+	uint8_t w; /* second x coordinate for lines, radius for circles */
+	uint8_t h; /* second y coordinate for lines */
+	uint16_t goldenCrc[2]; /* for the landscape and the transposed (portrait) framebuffer layout */
+} DisplayBenchCase;
+
+typedef struct {
+	uint16_t cycles; /* cpu cycles of a single call */
+	uint16_t crc;	 /* CRC16 of the framebuffer after the call */
+	bool passed;	 /* crc matches the golden value */
+} DisplayBenchResult;
+
+/** Run all benchmark cases. The framebuffer content is destroyed.
+ * @return number of cases whose framebuffer did not match the golden CRC
+ */
+uint8_t displayBenchRun();
+
+/** @return number of benchmark cases */
+uint8_t displayBenchCaseCount();
+
+const DisplayBenchResult* displayBenchResults();
+
+/** Copy a case out of program memory. */
+void displayBenchCase(uint8_t index, DisplayBenchCase* benchCase);
+
+/** Draw a case once into the framebuffer as it is, e.g. to time it with another clock. */
+void displayBenchDraw(const DisplayBenchCase* benchCase);
+
+/** Draw a single case once into the cleared framebuffer, e.g. to inspect a failed case. */
+void displayBenchDrawCase(uint8_t index);
+
+#ifdef DISPLAY_BENCH_REPORT
+/** Send the results of displayBenchRun() over the USART (DISPLAY_BENCH_REPORT_BAUD, 8N1), one CSV line
+ * per case: case,primitive,x,y,w,h,cycles,crc,golden,passed. The primitive is a DisplayBenchPrimitive.
+ * Waits until every line is queued, so interrupts have to be enabled.
+ */
+void displayBenchReport();
+#endif
+
+#endif
@@ -0,0 +1,36 @@
+/**
+ * @brief Framebuffer telemetry stream over the USART
+ *
+ * After every displayUpdate() the columns which changed since the last frame are sent.
+ * Only compiled in when TELEMETRY_ENABLED is defined, tools/telemetry_decode.py turns a
+ * captured stream back into an animation.
+ *
+ * Stream format:
+ *   frame:  0xA5 0x5A <frame number> <column>* 0xFF <checksum>
+ *   column: <x (0-127)> <page mask> <one byte per set bit in page mask, page 0 first>
+ * Pages which are not in the page mask are zero. The checksum is the 8 bit sum of all bytes
+ * between the sync bytes and the checksum.
+ */
+
+#ifndef _AVRHAL_DISPLAYTELEMETRY__H__
+#define _AVRHAL_DISPLAYTELEMETRY__H__
+
+#define TELEMETRY_BAUD 115200
+
+#ifdef TELEMETRY_ENABLED
+
+void displayTelemetrySetup();
+
+/** Queue the changes of the current framebuffer. Columns which do not fit into the
+ * transmit buffer are deferred to the next frame, so this never blocks. A frame is skipped
+ * if not even its header fits, the frame number is incremented nevertheless. */
+void displayTelemetrySendFrame();
+
+#else
+
+static inline void displayTelemetrySetup() {}
+static inline void displayTelemetrySendFrame() {}
+
+#endif
+
+#endif
@@ -0,0 +1,40 @@
+/**
+ * @brief Wear leveled, interrupt driven record storage in the EEPROM
+ *
+ * The whole EEPROM is divided into slots of EEPROM_STORE_RECORD_SIZE bytes. Every write goes to the
+ * slot after the last one, so each cell is only written once per EEPROM_STORE_SLOTS records.
+ * A slot holds a sequence number, the payload and a CRC8; after a power loss during a write the
+ * previous record is still intact and found by eepromStoreLoad().
+ *
+ * Writing is done byte by byte from the EEPROM ready interrupt (about 8.5 ms per byte), bytes
+ * which already hold the right value are skipped. eepromStoreWrite() only copies the record.
+ */
+
+#ifndef _AVRHAL_EEPROMSTORE__H__
+#define _AVRHAL_EEPROMSTORE__H__
+
+#include <avr/io.h>
+#include <stdbool.h>
+#include <stdint.h>
+
+#define EEPROM_STORE_RECORD_SIZE 32
+#define EEPROM_STORE_SLOTS ((E2END + 1) / EEPROM_STORE_RECORD_SIZE)
+/* Sequence number and CRC8 take one byte each */
+#define EEPROM_STORE_PAYLOAD_SIZE (EEPROM_STORE_RECORD_SIZE - 2)
+
+/** Find the newest valid record. Reads the whole EEPROM, takes about 1024 byte reads.
+ * Must be called once before the first eepromStoreWrite().
+ * @param payload receives size bytes (at most EEPROM_STORE_PAYLOAD_SIZE), untouched if nothing was found
+ * @return false if the EEPROM holds no valid record
+ */
+bool eepromStoreLoad(void* payload, uint8_t size);
+
+/** Store a record of size bytes (at most EEPROM_STORE_PAYLOAD_SIZE) in the background.
+ * If the previous record is still being written, it is replaced by this one.
+ */
+void eepromStoreWrite(const void* payload, uint8_t size);
+
+/** @return true while a record is written */
+bool eepromStoreBusy();
+
+#endif
@@ -0,0 +1,46 @@
+/**
+ * @brief Lock-free single producer / single consumer event queue
+ *
+ * A ring buffer of fixed size elements, e.g. to hand events from an interrupt to the main loop.
+ * The head index is only written by the producer and the tail index only by the consumer.
+ * Both are single bytes, whose accesses are atomic on the AVR, so no interrupts have to be disabled.
+ */
+
+#ifndef _AVRHAL_EVENTQUEUE__H__
+#define _AVRHAL_EVENTQUEUE__H__
+
+#include <stdbool.h>
+#include <stdint.h>
+
+typedef struct {
+	uint8_t* buffer;
+	uint8_t elementSize;
+	uint8_t mask; /* capacity - 1 */
+	volatile uint8_t head;
+	volatile uint8_t tail;
+	uint8_t dropped; /* events which didn't fit, only written by the producer */
+} EventQueue;
+
+/** Define a static queue for `capacity` elements of `type`.
+ * The capacity must be a power of two (at most 256), one element is always kept free.
+ */
+#define EVENT_QUEUE_DEFINE(name, type, capacity)                                             \
+	_Static_assert(((capacity) & ((capacity) - 1)) == 0 && (capacity) <= 256,              \
+				   "The event queue capacity must be a power of two");                     \
+	static uint8_t name##Buffer[(capacity) * sizeof(type)];                                  \
+	static EventQueue name = {.buffer = name##Buffer, .elementSize = sizeof(type), .mask = (capacity) - 1}
+
+/** Copy an event into the queue. Must only be called by the producer.
+ * @return false if the queue is full and the event was dropped
+ */
+bool eventQueuePush(EventQueue* queue, const void* event);
+
+/** Take the oldest event out of the queue. Must only be called by the consumer.
+ * @return false if the queue is empty
+ */
+bool eventQueuePop(EventQueue* queue, void* event);
+
+/** @return true if there is no event in the queue */
+bool eventQueueIsEmpty(const EventQueue* queue);
+
+#endif
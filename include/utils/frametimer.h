@@ -0,0 +1,66 @@
+/**
+ * @brief Frame pacing on Timer1
+ *
+ * Timer1 runs freely with a prescaler of 8 (1 us per tick @ 8 MHz) and is shared with the profiler.
+ * The frame interrupt is generated with output compare A, which is advanced by one frame period
+ * on every frame. The fractional part of the period is accumulated, so the average rate is exact.
+ *
+ * With PROFILE_ENABLED the delay between the scheduled tick and the start of the frame is
+ * collected in a histogram, which can be inspected with the JTAG debugger.
+ */
+
+#ifndef _AVRHAL_FRAMETIMER__H__
+#define _AVRHAL_FRAMETIMER__H__
+
+#include <stdint.h>
+
+/* Frames per second, e.g. 30, 60 or 120. 3 gray levels need 120 to look steady. */
+#ifndef FRAME_RATE
+#define FRAME_RATE 60
+#endif
+
+#define FRAME_TIMER_PRESCALER 8
+#define FRAME_TIMER_TICKS_PER_SECOND (F_CPU / FRAME_TIMER_PRESCALER)
+/* Whole timer ticks per frame, the remainder is distributed over the frames of a second */
+#define FRAME_TIMER_TICKS (FRAME_TIMER_TICKS_PER_SECOND / FRAME_RATE)
+
+#if FRAME_TIMER_TICKS > 0xFFFF
+#error "FRAME_RATE is too low for the 16 bit frame timer"
+#endif
+
+/** Number of frames (at least 1) which last about the given time, for durations independent of the frame rate */
+#define FRAMES_FROM_MS(ms) ((((ms) * FRAME_RATE + 500UL) / 1000UL) ? (((ms) * FRAME_RATE + 500UL) / 1000UL) : 1)
+
+#define FRAME_TIMER_JITTER_BUCKETS 8
+#define FRAME_TIMER_JITTER_BUCKET_TICKS 4
+
+typedef struct {
+	/* Delay of the frame start after its scheduled tick, bucket i counts delays of
+	 * i * FRAME_TIMER_JITTER_BUCKET_TICKS up to below (i + 1) * FRAME_TIMER_JITTER_BUCKET_TICKS ticks.
+	 * The last bucket also counts all longer delays. */
+	uint16_t histogram[FRAME_TIMER_JITTER_BUCKETS];
+	uint16_t maxDelay; /* ticks */
+	uint16_t frames;
+	uint16_t missedFrames; /* the previous frame took so long, that whole frames were skipped */
+} FrameTimerStats;
+
+/** Start Timer1 as free running counter. Must be called before the profiler is used. */
+void frameTimerSetup();
+
+/** Schedule the first frame one period from now and enable the frame interrupt (TIMER1_COMPA_vect). */
+void frameTimerStart();
+
+/** Disable the frame interrupt, the counter keeps running. */
+void frameTimerStop();
+
+/** Must be called first in the frame interrupt: schedules the next frame and collects the jitter statistics. */
+void frameTimerStartFrame();
+
+/** @return the current timer tick count */
+uint16_t frameTimerNow();
+
+#ifdef PROFILE_ENABLED
+const FrameTimerStats* frameTimerStats();
+#endif
+
+#endif
@@ -0,0 +1,67 @@
+/**
+ * @brief Lightweight stage profiler based on Timer1
+ *
+ * Only compiled in when PROFILE_ENABLED is defined (see platformio.ini), otherwise
+ * all calls collapse to empty inline functions. The collected statistics are kept in
+ * RAM and can be inspected with the JTAG debugger, with PROFILE_REPORT they are also
+ * sent over the USART.
+ */
+
+#ifndef _AVRHAL_PROFILE__H__
+#define _AVRHAL_PROFILE__H__
+
+#include <stdint.h>
+
+/* Timer1 runs with a prescaler of 8, so one tick equals 8 cpu cycles (1 us @ 8 MHz) */
+#define PROFILE_CYCLES_PER_TICK 8
+
+#define PROFILE_REPORT_BAUD 115200
+
+typedef enum {
+	PROFILE_STAGE_UPDATE,
+	PROFILE_STAGE_DRAW,
+	PROFILE_STAGE_FLUSH,
+	PROFILE_STAGE_SOUND,
+	PROFILE_STAGE_INPUT_TO_FLUSH, /* from sampling the joystick until the platform and ball are sent to the display */
+	PROFILE_STAGE_COUNT
+} ProfileStage;
+
+typedef struct {
+	uint16_t last; /* all durations are given in timer ticks */
+	uint16_t min;
+	uint16_t max;
+	uint32_t total;
+	uint16_t count;
+} ProfileStats;
+
+#ifdef PROFILE_ENABLED
+
+/** Reset all statistics. Timer1 has to run already, see frameTimerSetup(). */
+void profileInit();
+
+/** @return the current tick count, usable for custom measurements */
+uint16_t profileNow();
+
+void profileBegin(ProfileStage stage);
+void profileEnd(ProfileStage stage);
+
+const ProfileStats* profileStats(ProfileStage stage);
+
+#ifdef PROFILE_REPORT
+/** Send the statistics of all stages over the USART (PROFILE_REPORT_BAUD, 8N1), one CSV line per stage:
+ * stage,count,last,min,max,average with the stage as ProfileStage number and all durations in cpu cycles.
+ * Waits until every line is queued, so it has to be called with interrupts enabled, e.g. from the main loop.
+ */
+void profileReport();
+#endif
+
+#else
+
+static inline void profileInit() {}
+static inline uint16_t profileNow() { return 0; }
+static inline void profileBegin(__attribute__((unused)) ProfileStage stage) {}
+static inline void profileEnd(__attribute__((unused)) ProfileStage stage) {}
+
+#endif
+
+#endif
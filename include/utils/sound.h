@@ -0,0 +1,48 @@
+/**
+ * @brief Sound effects for a piezo on OC2 (PD7)
+ *
+ * Timer2 runs in CTC mode and toggles OC2 in hardware, so a note plays without any CPU time.
+ * Effects are PROGMEM note lists which are sequenced by soundTick() once per frame:
+ * between note changes this is a single counter decrement, a note change reloads OCR2.
+ * Effects are queued and played one after the other, playing never blocks the caller.
+ */
+
+#ifndef _AVRHAL_SOUND__H__
+#define _AVRHAL_SOUND__H__
+
+#include <stdbool.h>
+#include <stdint.h>
+
+/* Timer2 prescaler, determines the playable range: F_CPU / (2 * 64 * 256) - F_CPU / (2 * 64) (244 Hz - 62 kHz @ 8 MHz) */
+#define SOUND_PRESCALER 64
+
+/** Compare value for a note with the given frequency in Hz, rounded. */
+#define SOUND_NOTE_HZ(hz) ((uint8_t)((F_CPU / SOUND_PRESCALER + (hz)) / (2UL * (hz)) - 1))
+/** A pause instead of a note */
+#define SOUND_REST 0
+/** Terminates every effect */
+#define SOUND_END {0, 0}
+
+/* Must be a power of two */
+#define SOUND_QUEUE_SIZE 4
+
+typedef struct {
+	uint8_t ocr;	/* compare value, see SOUND_NOTE_HZ, or SOUND_REST */
+	uint8_t frames; /* duration in frames, 0 ends the effect */
+} SoundNote;
+
+/** Setup Timer2 and the OC2 pin. The piezo is silent until an effect is played. */
+void soundSetup();
+
+/** Queue an effect (a SOUND_END terminated note list in program memory).
+ * The effect is dropped if the queue is full.
+ */
+void soundPlay(const SoundNote* effect);
+
+/** Advance the sequencer by one frame. Must be called once per frame. */
+void soundTick();
+
+/** @return true while an effect is played or queued. Reads the sequencer state, so like soundTick() it belongs into the frame interrupt. */
+bool soundBusy();
+
+#endif
@@ -11,11 +11,16 @@
 
 #define SPI_DDR DDRB
 
-#define SPI_CS PB4
+/* The hardware slave select pin has to be an output in master mode, otherwise a low level would switch the
+ * SPI into slave mode. It is therefore used as display D/C line and not as chip select (see displaybackend.h). */
+#define SPI_SS PB4
 #define SPI_MOSI PB5
 #define SPI_MISO PB6
 #define SPI_SCK PB7
 
+/* SPI2X is set and the clock rate select bits are left at zero */
+#define SPI_CLOCK (F_CPU / 2)
+
 /** Setup the hardware spi interface as master */
 void spiSetup();
 
@@ -26,4 +31,10 @@ void spiSetup();
  */
 uint8_t spiTransferByte(uint8_t data);
 
+/** Transmit count bytes, taking every stride-th byte starting at data. Received bytes are discarded.
+ *  The next byte is fetched while the previous one is still shifted out, which keeps the bus busy
+ *  without gaps between the bytes.
+ */
+void spiTransmit(const uint8_t* data, uint16_t count, uint8_t stride);
+
 #endif
@@ -0,0 +1,28 @@
+/**
+ * @brief Interrupt driven USART transmitter
+ *
+ * Bytes are queued in a ring buffer and sent from the data register empty interrupt,
+ * so writing never blocks the caller.
+ */
+
+#ifndef _AVRHAL_USART__H__
+#define _AVRHAL_USART__H__
+
+#include <stdbool.h>
+#include <stdint.h>
+
+/* Must be a power of two */
+#define USART_TX_BUFFER_SIZE 128
+
+/** Setup the USART as 8N1 transmitter with the given baud rate. Double speed mode is used to reduce the baud rate error. */
+void usartSetup(uint32_t baud);
+
+/** Queue a byte for transmission.
+ * @return false if the buffer is full and the byte was dropped
+ */
+bool usartWriteByte(uint8_t data);
+
+/** @return number of bytes that can currently be queued without dropping data */
+uint8_t usartTxFree();
+
+#endif
@@ -0,0 +1,79 @@
+/**
+ * @brief Run the display primitive benchmark on the host
+ *
+ * Prints one CSV line per case to stdout. The framebuffer of every case whose CRC doesn't match
+ * the golden value is written to bench_<case>.pbm in the logical orientation, to compare it with
+ * the expected drawing. Timer1 only resolves microseconds on the host, so every case is timed
+ * here with the monotonic clock instead and reported in nanoseconds per call: they show relative
+ * changes, not the cycles on the AVR. The exit code is the number of failed cases.
+ */
+
+#include <stdio.h>
+#include <time.h>
+
+#include "utils/disp/display.h"
+#include "utils/disp/displaybench.h"
+
+/* Enough calls that even the fastest primitives take several microseconds */
+#define BENCH_REPETITIONS 10000
+
+static const char* const primitiveNames[] = {
+	[DISPLAY_BENCH_LINE] = "line",
+	[DISPLAY_BENCH_RECTANGLE] = "rectangle",
+	[DISPLAY_BENCH_FILLED_RECTANGLE] = "filled_rectangle",
+	[DISPLAY_BENCH_CIRCLE] = "circle",
+	[DISPLAY_BENCH_FILLED_CIRCLE] = "filled_circle",
+	[DISPLAY_BENCH_BITMAP] = "bitmap",
+	[DISPLAY_BENCH_TEXT] = "text",
+};
+
+/** @return nanoseconds of a single call of the case, averaged over BENCH_REPETITIONS */
+static double benchTime(const DisplayBenchCase* c) {
+	displayClearBuffer();
+	struct timespec start, end;
+	clock_gettime(CLOCK_MONOTONIC, &start);
+	for (uint16_t r = 0; r < BENCH_REPETITIONS; ++r) {
+		displayBenchDraw(c);
+	}
+	clock_gettime(CLOCK_MONOTONIC, &end);
+	return ((end.tv_sec - start.tv_sec) * 1e9 + (end.tv_nsec - start.tv_nsec)) / BENCH_REPETITIONS;
+}
+
+/** Write the logical framebuffer as plain PBM */
+static void benchWritePbm(const char* path) {
+	FILE* file = fopen(path, "w");
+	if (file == NULL) {
+		perror(path);
+		return;
+	}
+	fprintf(file, "P1\n%u %u\n", DISPLAY_WIDTH, DISPLAY_HEIGHT);
+	for (uint16_t y = 0; y < DISPLAY_HEIGHT; ++y) {
+		for (uint16_t x = 0; x < DISPLAY_WIDTH; ++x) {
+			fputc(displayGetPixel(x, y) ? '1' : '0', file);
+		}
+		fputc('\n', file);
+	}
+	fclose(file);
+}
+
+int main() {
+	const uint8_t failed = displayBenchRun();
+	const DisplayBenchResult* results = displayBenchResults();
+
+	printf("case,primitive,x,y,w,h,ns,crc,golden,passed\n");
+	for (uint8_t i = 0; i < displayBenchCaseCount(); ++i) {
+		DisplayBenchCase c;
+		displayBenchCase(i, &c);
+		const DisplayBenchResult* result = &results[i];
+		printf("%u,%s,%u,%u,%u,%u,%.1f,0x%04X,0x%04X,%u\n", i, primitiveNames[c.primitive], c.x, c.y, c.w, c.h,
+			   benchTime(&c), result->crc, c.goldenCrc[DISPLAY_TRANSPOSED], result->passed);
+
+		if (!result->passed) {
+			char path[32];
+			snprintf(path, sizeof(path), "bench_%u.pbm", i);
+			displayBenchDrawCase(i);
+			benchWritePbm(path);
+		}
+	}
+	return failed;
+}
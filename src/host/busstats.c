@@ -0,0 +1,106 @@
+/**
+ * @brief Report the SPI bus traffic of the display driver
+ *
+ * Runs the driver against the SH1106 emulator, prints command/data bytes and the estimated bus
+ * time for the setup, a full and a partial flush as "key=value" lines, and checks that the
+ * emulated display shows exactly the logical drawing for the configured DISPLAY_ORIENTATION.
+ * Finally the flicker of every gray level is measured on the emulated display at FRAME_RATE.
+ */
+
+#include <stdio.h>
+
+#include "panelposition.h"
+#include "sh1106emu.h"
+#include "utils/disp/display.h"
+#include "utils/frametimer.h"
+#include "utils/spi.h"
+
+static void busStatsReport(const char* name) {
+	const Sh1106EmuStats stats = sh1106EmuTakeStats();
+	printf("%s command_bytes=%u data_bytes=%u address_commands=%u unknown_commands=%u bus_time_us=%u\n",
+		   name, stats.commandBytes, stats.dataBytes, stats.addressCommands, stats.unknownCommands,
+		   sh1106EmuBusTimeUs(&stats, SPI_CLOCK));
+}
+
+/** @return number of visible pixels which differ between the logical drawing and the emulated display */
+static uint16_t busStatsCompare() {
+	uint16_t differences = 0;
+	for (uint8_t x = 0; x < DISPLAY_WIDTH; ++x) {
+		for (uint8_t y = 0; y < DISPLAY_HEIGHT; ++y) {
+			uint8_t panelX, panelY;
+			panelPosition(x, y, &panelX, &panelY);
+			if (displayGetPixel(x, y) != sh1106EmuPixel(panelX, panelY)) {
+				differences++;
+			}
+		}
+	}
+	return differences;
+}
+
+#define BUS_STATS_GRAY_FRAMES 120
+
+/** Flush a single gray pixel for a number of frames and count how often it lights up on the emulated display */
+static void busStatsGrayFlicker() {
+	uint8_t panelX, panelY;
+	panelPosition(0, 0, &panelX, &panelY);
+
+	for (uint8_t level = DISPLAY_GRAY_BLACK + 1; level < DISPLAY_GRAY_WHITE; ++level) {
+		uint8_t onFrames = 0;
+		uint8_t flashes = 0;
+		bool wasOn = false;
+		for (uint8_t frame = 0; frame < BUS_STATS_GRAY_FRAMES; ++frame) {
+			displayClearBuffer();
+			displaySetGray(level);
+			displayDrawPixel(0, 0);
+			displaySetGray(DISPLAY_GRAY_WHITE);
+			displayUpdate();
+
+			const bool on = sh1106EmuPixel(panelX, panelY);
+			onFrames += on;
+			flashes += on && !wasOn;
+			wasOn = on;
+		}
+		printf("gray level=%u on_frames=%u frames=%u flicker_hz=%u frame_rate=%u\n", level, onFrames,
+			   BUS_STATS_GRAY_FRAMES, (uint16_t)((uint32_t)flashes * FRAME_RATE / BUS_STATS_GRAY_FRAMES), FRAME_RATE);
+	}
+}
+
+int main() {
+	displaySetup();
+	busStatsReport("setup");
+
+	displayDrawRectangle(0, 0, DISPLAY_WIDTH, DISPLAY_HEIGHT - 1);
+	displayDrawFilledCircle(30, 30, 20);
+	displayDrawLine(5, 50, 60, 120);
+	displayRenderText(4, 55, "SH1106");
+	displayUpdate();
+	busStatsReport("flush");
+
+	const uint16_t differences = busStatsCompare();
+	printf("flush pixel_differences=%u\n", differences);
+
+	/* With several panels unchanged ones are skipped, so the region gets a pixel (page 2, column 60) */
+	displayDrawPixel(DISPLAY_TRANSPOSED ? 16 : 60, DISPLAY_TRANSPOSED ? 60 : 16);
+	displayUpdateRegion(2, 3, 60, 99);
+	busStatsReport("flush_region");
+
+	/* Latency first order of the game: the bottom row (platform) and two rows (ball) are sent before the rest,
+	 * the bus time of the first part is what the input has to wait for */
+	displayClearBuffer();
+	displayDrawHorizontalLine(20, DISPLAY_HEIGHT - 1, 15);
+	displayDrawRectangle(30, 60, 2, 2);
+	displayUpdateRows(DISPLAY_HEIGHT - 1, DISPLAY_HEIGHT - 1);
+	displayUpdateRows(60, 61);
+	busStatsReport("flush_priority_rows");
+	displayUpdateRows(0, 59);
+	displayUpdateRows(62, DISPLAY_HEIGHT - 2);
+	displayEndFrame();
+	busStatsReport("flush_remaining_rows");
+
+	const uint16_t rowDifferences = busStatsCompare();
+	printf("flush_rows pixel_differences=%u\n", rowDifferences);
+
+	busStatsGrayFlicker();
+
+	return (differences == 0 && rowDifferences == 0) ? 0 : 1;
+}
@@ -0,0 +1,15 @@
+/**
+ * @brief Host stand-in for the AVR interrupt macros
+ *
+ * Interrupt service routines become ordinary functions which the host frontend calls itself.
+ */
+
+#ifndef _HOST_AVR_INTERRUPT__H__
+#define _HOST_AVR_INTERRUPT__H__
+
+#define ISR(vector) void vector(void)
+
+#define sei()
+#define cli()
+
+#endif
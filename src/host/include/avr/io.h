@@ -0,0 +1,54 @@
+/**
+ * @brief Host stand-in for the AVR register definitions
+ *
+ * Registers are plain variables (defined in src/host/io.c), so the unmodified driver and game
+ * code can run on the host. Only the registers used outside of the replaced hardware modules exist.
+ */
+
+#ifndef _HOST_AVR_IO__H__
+#define _HOST_AVR_IO__H__
+
+#include <stdint.h>
+
+extern volatile uint8_t PORTB;
+extern volatile uint8_t DDRB;
+
+#define PB0 0
+#define PB1 1
+#define PB2 2
+#define PB3 3
+#define PB4 4
+#define PB5 5
+#define PB6 6
+#define PB7 7
+
+/* Timer1, the counter follows the host clock at F_CPU / 8. The compare interrupt is raised by the
+ * terminal frontend, the busstats build doesn't use the timer. */
+uint16_t hostTimer1();
+#define TCNT1 hostTimer1()
+extern volatile uint8_t TCCR1A;
+extern volatile uint8_t TCCR1B;
+extern volatile uint16_t OCR1A;
+extern volatile uint8_t TIFR;
+extern volatile uint8_t TIMSK;
+
+#define CS11 1
+#define OCF1A 4
+#define OCIE1A 4
+
+/* Timer2 and OC2 (PD7) of the sound, nothing is played on the host */
+extern volatile uint8_t TCCR2;
+extern volatile uint8_t OCR2;
+extern volatile uint8_t TCNT2;
+extern volatile uint8_t PORTD;
+extern volatile uint8_t DDRD;
+
+#define CS22 2
+#define WGM21 3
+#define COM20 4
+#define PD7 7
+
+/* EEPROM size of the ATmega32 */
+#define E2END 0x3FF
+
+#endif
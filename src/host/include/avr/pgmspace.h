@@ -0,0 +1,19 @@
+/**
+ * @brief Host stand-in for the AVR program memory access
+ *
+ * The host has a single address space, so program memory is ordinary constant data.
+ */
+
+#ifndef _HOST_AVR_PGMSPACE__H__
+#define _HOST_AVR_PGMSPACE__H__
+
+#include <stdint.h>
+#include <string.h>
+
+#define PROGMEM
+
+#define pgm_read_byte(address) (*(const uint8_t*)(address))
+#define pgm_read_word(address) (*(const uint16_t*)(address))
+#define memcpy_P memcpy
+
+#endif
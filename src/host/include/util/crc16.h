@@ -0,0 +1,20 @@
+/**
+ * @brief Host stand-in for the AVR CRC routines
+ *
+ * The C equivalent given in the avr-libc documentation, used by the display benchmark.
+ */
+
+#ifndef _HOST_UTIL_CRC16__H__
+#define _HOST_UTIL_CRC16__H__
+
+#include <stdint.h>
+
+static inline uint16_t _crc16_update(uint16_t crc, uint8_t a) {
+	crc ^= a;
+	for (uint8_t i = 0; i < 8; ++i) {
+		crc = (crc & 1) ? (crc >> 1) ^ 0xA001 : (crc >> 1);
+	}
+	return crc;
+}
+
+#endif
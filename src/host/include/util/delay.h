@@ -0,0 +1,13 @@
+/**
+ * @brief Host stand-in for the AVR busy waiting delays
+ *
+ * Delays are only used for the display reset, which the emulator doesn't need to wait for.
+ */
+
+#ifndef _HOST_UTIL_DELAY__H__
+#define _HOST_UTIL_DELAY__H__
+
+static inline void _delay_ms(__attribute__((unused)) double ms) {}
+static inline void _delay_us(__attribute__((unused)) double us) {}
+
+#endif
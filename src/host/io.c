@@ -0,0 +1,24 @@
+#include <avr/io.h>
+#include <time.h>
+
+volatile uint8_t PORTB;
+volatile uint8_t DDRB;
+
+volatile uint8_t TCCR1A;
+volatile uint8_t TCCR1B;
+volatile uint16_t OCR1A;
+volatile uint8_t TIFR;
+volatile uint8_t TIMSK;
+
+volatile uint8_t TCCR2;
+volatile uint8_t OCR2;
+volatile uint8_t TCNT2;
+volatile uint8_t PORTD;
+volatile uint8_t DDRD;
+
+uint16_t hostTimer1() {
+	struct timespec now;
+	clock_gettime(CLOCK_MONOTONIC, &now);
+	/* prescaler 8 */
+	return (uint16_t)(((uint64_t)now.tv_sec * (F_CPU / 8)) + (uint64_t)now.tv_nsec * (F_CPU / 8) / 1000000000UL);
+}
@@ -0,0 +1,31 @@
+/**
+ * @brief Logical to panel coordinates for host builds
+ *
+ * Maps a logical pixel to its position on the (unrotated) panel for the configured
+ * DISPLAY_ORIENTATION, so the emulated display can be read in logical coordinates.
+ */
+
+#ifndef _HOST_PANELPOSITION__H__
+#define _HOST_PANELPOSITION__H__
+
+#include <stdint.h>
+
+#include "utils/disp/display.h"
+
+static inline void panelPosition(uint8_t x, uint8_t y, uint8_t* panelX, uint8_t* panelY) {
+#if DISPLAY_ORIENTATION == 90
+	*panelX = DISPLAY_COLUMNS - 1 - y;
+	*panelY = x;
+#elif DISPLAY_ORIENTATION == 180
+	*panelX = DISPLAY_COLUMNS - 1 - x;
+	*panelY = DISPLAY_ROWS - 1 - y;
+#elif DISPLAY_ORIENTATION == 270
+	*panelX = y;
+	*panelY = DISPLAY_ROWS - 1 - x;
+#else
+	*panelX = x;
+	*panelY = y;
+#endif
+}
+
+#endif
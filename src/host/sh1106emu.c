@@ -0,0 +1,144 @@
+#include "sh1106emu.h"
+
+#include <string.h>
+
+#define SH1106_EMU_DEFAULT_CONTRAST 0x80
+
+static Sh1106EmuState state;
+static Sh1106EmuStats stats;
+/* Commands with an argument byte store their first byte here until the argument arrives */
+static uint8_t pendingCommand;
+
+void sh1106EmuReset() {
+	memset(&state, 0, sizeof(state));
+	state.contrast = SH1106_EMU_DEFAULT_CONTRAST;
+	state.multiplexRatio = SH1106_EMU_ROWS - 1;
+	memset(&stats, 0, sizeof(stats));
+	pendingCommand = 0;
+}
+
+static void sh1106EmuCommandArgument(uint8_t command, uint8_t argument) {
+	switch (command) {
+		case 0x81:
+			state.contrast = argument;
+			break;
+		case 0xA8:
+			state.multiplexRatio = argument & 0x3F;
+			break;
+		case 0xD3:
+			state.displayOffset = argument & 0x3F;
+			break;
+		default:
+			/* DC-DC, clock divider, precharge, COM pins and VCOM level don't change the image */
+			break;
+	}
+}
+
+static void sh1106EmuCommand(uint8_t command) {
+	if (pendingCommand) {
+		sh1106EmuCommandArgument(pendingCommand, command);
+		pendingCommand = 0;
+		return;
+	}
+
+	if (command <= 0x0F) {
+		state.column = (state.column & 0xF0) | command;
+		stats.addressCommands++;
+	} else if (command <= 0x1F) {
+		state.column = (state.column & 0x0F) | ((command & 0x0F) << 4);
+		stats.addressCommands++;
+	} else if (command >= 0x30 && command <= 0x33) {
+		/* pump voltage */
+	} else if (command >= 0x40 && command <= 0x7F) {
+		state.startLine = command & 0x3F;
+	} else if (command >= 0xB0 && command <= 0xB7) {
+		state.page = command & 0x07;
+		stats.addressCommands++;
+	} else {
+		switch (command) {
+			case 0x81:
+			case 0xA8:
+			case 0xAD:
+			case 0xD3:
+			case 0xD5:
+			case 0xD9:
+			case 0xDA:
+			case 0xDB:
+				pendingCommand = command;
+				break;
+			case 0xA0:
+			case 0xA1:
+				state.segmentRemap = command & 1;
+				break;
+			case 0xA4:
+			case 0xA5:
+				state.entireDisplayOn = command & 1;
+				break;
+			case 0xA6:
+			case 0xA7:
+				state.inverted = command & 1;
+				break;
+			case 0xAE:
+			case 0xAF:
+				state.displayOn = command & 1;
+				break;
+			case 0xC0:
+			case 0xC8:
+				state.comScanDecrement = command & 0x08;
+				break;
+			case 0xE0: /* read-modify-write start, end and nop */
+			case 0xEE:
+			case 0xE3:
+				break;
+			default:
+				stats.unknownCommands++;
+				break;
+		}
+	}
+}
+
+void sh1106EmuReceive(bool isData, uint8_t byte) {
+	if (!isData) {
+		stats.commandBytes++;
+		sh1106EmuCommand(byte);
+		return;
+	}
+
+	stats.dataBytes++;
+	if (state.column < SH1106_EMU_COLUMNS) {
+		state.ram[state.page][state.column] = byte;
+		state.column++;
+	}
+}
+
+const Sh1106EmuState* sh1106EmuState() {
+	return &state;
+}
+
+bool sh1106EmuPixel(uint8_t x, uint8_t y) {
+	if (!state.displayOn || y > state.multiplexRatio) {
+		return false;
+	}
+	if (state.entireDisplayOn) {
+		return true;
+	}
+
+	const uint8_t segment = x + SH1106_EMU_VISIBLE_OFFSET;
+	const uint8_t column = state.segmentRemap ? SH1106_EMU_COLUMNS - 1 - segment : segment;
+	const uint8_t com = state.comScanDecrement ? state.multiplexRatio - y : y;
+	const uint8_t line = (com + state.startLine + state.displayOffset) % SH1106_EMU_ROWS;
+
+	const bool lit = (state.ram[line / 8][column] >> (line % 8)) & 1;
+	return lit != state.inverted;
+}
+
+Sh1106EmuStats sh1106EmuTakeStats() {
+	const Sh1106EmuStats result = stats;
+	memset(&stats, 0, sizeof(stats));
+	return result;
+}
+
+uint32_t sh1106EmuBusTimeUs(const Sh1106EmuStats* s, uint32_t spiClock) {
+	const uint64_t bits = (uint64_t)(s->commandBytes + s->dataBytes) * 8;
+	return (uint32_t)(bits * 1000000 / spiClock);
+}
@@ -0,0 +1,63 @@
+/**
+ * @brief SH1106 command stream emulator for host builds
+ *
+ * Decodes the D/C tagged byte stream the display driver puts on the SPI bus and keeps the
+ * display RAM and the controller registers, so the transferred image and the bus traffic can be
+ * inspected without hardware. Only the SH1106 command set is modeled.
+ */
+
+#ifndef _HOST_SH1106EMU__H__
+#define _HOST_SH1106EMU__H__
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#define SH1106_EMU_COLUMNS 132
+#define SH1106_EMU_PAGES 8
+#define SH1106_EMU_ROWS 64
+/* The 128 visible segments are centered in the 132 column RAM */
+#define SH1106_EMU_VISIBLE_OFFSET 2
+
+typedef struct {
+	uint8_t ram[SH1106_EMU_PAGES][SH1106_EMU_COLUMNS];
+	uint8_t page;
+	uint8_t column;
+	uint8_t startLine;
+	uint8_t displayOffset;
+	uint8_t multiplexRatio;
+	uint8_t contrast;
+	bool displayOn;
+	bool inverted;
+	bool entireDisplayOn;
+	bool segmentRemap;
+	bool comScanDecrement;
+} Sh1106EmuState;
+
+typedef struct {
+	uint32_t commandBytes;
+	uint32_t dataBytes;
+	uint32_t unknownCommands; /* bytes sent as command which the SH1106 does not implement */
+	uint32_t addressCommands; /* page and column selections */
+} Sh1106EmuStats;
+
+/** Bring the emulator into the power-on reset state and clear the statistics. */
+void sh1106EmuReset();
+
+/** Feed one byte from the bus.
+ * @param[in] isData state of the D/C line while the byte was transferred
+ */
+void sh1106EmuReceive(bool isData, uint8_t byte);
+
+const Sh1106EmuState* sh1106EmuState();
+
+/** @return whether the pixel at the visible position (x: 0-127, y: 0-63) is lit,
+ * taking display on/off, inversion, start line, offset and scan directions into account */
+bool sh1106EmuPixel(uint8_t x, uint8_t y);
+
+/** @return the statistics collected since the last call (or reset) and restart counting */
+Sh1106EmuStats sh1106EmuTakeStats();
+
+/** @return the time the given traffic occupies the bus in microseconds at the given SPI clock */
+uint32_t sh1106EmuBusTimeUs(const Sh1106EmuStats* stats, uint32_t spiClock);
+
+#endif
@@ -0,0 +1,27 @@
+/**
+ * @brief Host replacement of the SPI master, which feeds the SH1106 emulator
+ *
+ */
+
+#include "utils/spi.h"
+
+#include <avr/io.h>
+
+#include "bit.h"
+#include "sh1106emu.h"
+#include "utils/disp/displaybackend.h"
+
+void spiSetup() {
+	sh1106EmuReset();
+}
+
+uint8_t spiTransferByte(uint8_t data) {
+	sh1106EmuReceive(BIT_IS_SET(PORTB, DISPLAY_DATA_CMD_PIN), data);
+	return 0;
+}
+
+void spiTransmit(const uint8_t* data, uint16_t count, uint8_t stride) {
+	for (; count > 0; --count, data += stride) {
+		spiTransferByte(*data);
+	}
+}
@@ -0,0 +1,43 @@
+/**
+ * @brief File backed replacement of the EEPROM store for the terminal frontend
+ *
+ * The newest record is kept in EEPROM_STORE_FILE in the working directory, so a game is resumed
+ * when the frontend is started again. Writes complete immediately. Only async-signal-safe calls
+ * are used, the game saves from its frame interrupt, which is a signal handler on the host.
+ */
+
+#include <fcntl.h>
+#include <string.h>
+#include <unistd.h>
+
+#include "utils/eepromstore.h"
+
+#define EEPROM_STORE_FILE "brickbreaker.eeprom"
+
+bool eepromStoreLoad(void* payload, uint8_t size) {
+	const int file = open(EEPROM_STORE_FILE, O_RDONLY);
+	if (file < 0) {
+		return false;
+	}
+	uint8_t record[EEPROM_STORE_PAYLOAD_SIZE];
+	const bool found = read(file, record, size) == size;  /* an incomplete record is ignored */
+	close(file);
+	if (found) {
+		memcpy(payload, record, size);
+	}
+	return found;
+}
+
+void eepromStoreWrite(const void* payload, uint8_t size) {
+	const int file = open(EEPROM_STORE_FILE, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+	if (file < 0) {
+		return;
+	}
+	const ssize_t written = write(file, payload, size);
+	(void)written;
+	close(file);
+}
+
+bool eepromStoreBusy() {
+	return false;
+}
@@ -0,0 +1,54 @@
+#include "keyboard.h"
+
+#include <stdint.h>
+#include <unistd.h>
+
+#include "joystick.h"
+
+/* ADC values as returned by joystickRead() */
+#define KEYBOARD_STICK_LEFT 0
+#define KEYBOARD_STICK_CENTER 512
+#define KEYBOARD_STICK_RIGHT 1023
+
+static volatile uint16_t stick = KEYBOARD_STICK_CENTER;
+
+void joystickInit() {
+	stick = KEYBOARD_STICK_CENTER;
+}
+
+void requestJoystickUpdate() {}
+
+uint16_t joystickRead() {
+	return stick;
+}
+
+bool keyboardPoll() {
+	char keys[32];
+	const ssize_t count = read(STDIN_FILENO, keys, sizeof(keys));
+
+	for (ssize_t i = 0; i < count; ++i) {
+		char key = keys[i];
+		/* arrow keys arrive as ESC [ A-D */
+		if (key == '\x1b' && i + 2 < count && keys[i + 1] == '[') {
+			key = keys[i + 2];
+			i += 2;
+			key = key == 'D' ? 'a' : key == 'C' ? 'd' : key == 'B' ? 's' : 0;
+		}
+
+		switch (key) {
+			case 'a':
+				stick = KEYBOARD_STICK_LEFT;
+				break;
+			case 'd':
+				stick = KEYBOARD_STICK_RIGHT;
+				break;
+			case 's':
+			case ' ':
+				stick = KEYBOARD_STICK_CENTER;
+				break;
+			case 'q':
+				return false;
+		}
+	}
+	return true;
+}
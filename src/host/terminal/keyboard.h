@@ -0,0 +1,19 @@
+/**
+ * @brief Keyboard in place of the joystick for the terminal frontend
+ *
+ * Implements joystick.h. A terminal only reports key presses (and their auto repeat), not releases,
+ * so the virtual stick latches: the left/right arrows (or a/d) push it to the end, s, space or the
+ * down arrow center it again.
+ */
+
+#ifndef _HOST_KEYBOARD__H__
+#define _HOST_KEYBOARD__H__
+
+#include <stdbool.h>
+
+/** Handle the keys pressed since the last call, stdin has to be in non-canonical, non-blocking mode.
+ * @return false if q was pressed
+ */
+bool keyboardPoll();
+
+#endif
@@ -0,0 +1,290 @@
+/**
+ * @brief Interactive terminal frontend for host builds
+ *
+ * Runs the unmodified game (main.c) with the display driver against the SH1106 emulator and shows
+ * the emulated panel in the terminal, in the logical orientation of the game. The keyboard stands
+ * in for the joystick (see keyboard.h), the EEPROM is a file (see eepromfile.c).
+ *
+ * The frame interrupt is a SIGALRM: the timer is armed for the Timer1 compare value, so main()
+ * of the game keeps spinning in its event loop and is interrupted just like on the AVR.
+ * After every frame the panel, the profiler stages and the frame timer statistics are printed.
+ * All timings are host microseconds, they show relative changes, not the cycles on the AVR.
+ *
+ * Formatting isn't async-signal-safe, so the signal handler only copies what is shown into a
+ * frame and posts it to a render thread, which formats and writes it. A frame which is finished
+ * while the previous one is still written is skipped, the newest one is shown afterwards.
+ */
+
+#include <avr/io.h>
+#include <pthread.h>
+#include <semaphore.h>
+#include <signal.h>
+#include <stdarg.h>
+#include <stdio.h>
+#include <sys/time.h>
+#include <termios.h>
+#include <time.h>
+#include <unistd.h>
+
+#include "bit.h"
+#include "keyboard.h"
+#include "panelposition.h"
+#include "sh1106emu.h"
+#include "utils/disp/display.h"
+#include "utils/frametimer.h"
+#include "utils/profile.h"
+#include "utils/sound.h"
+
+#ifndef PROFILE_ENABLED
+#error "The terminal frontend shows the profiler stages, build it with PROFILE_ENABLED"
+#endif
+
+#if DISPLAY_PANELS != 1
+#error "The SH1106 emulator models a single panel"
+#endif
+
+/* Period of the ticks which read the keyboard while the frame interrupt is disabled. Shorter than
+ * a frame, so the first compare match after frameTimerStart() isn't missed. */
+#define TERMINAL_IDLE_US 2000
+#define TERMINAL_BUFFER_SIZE 16384
+
+/* Timer1 ticks (prescaler 8) to microseconds */
+#define TERMINAL_TICKS_TO_US(ticks) ((uint32_t)(ticks) * 8000000UL / F_CPU)
+
+/* The frame interrupt of the game */
+void TIMER1_COMPA_vect(void);
+
+static const char* const stageNames[PROFILE_STAGE_COUNT] = {
+	[PROFILE_STAGE_UPDATE] = "update",
+	[PROFILE_STAGE_DRAW] = "draw",
+	[PROFILE_STAGE_FLUSH] = "flush",
+	[PROFILE_STAGE_SOUND] = "sound",
+	[PROFILE_STAGE_INPUT_TO_FLUSH] = "input to flush",
+};
+
+/* Everything which is shown of a frame, taken by the signal handler */
+typedef struct {
+	bool pixels[DISPLAY_HEIGHT][DISPLAY_WIDTH];
+	FrameTimerStats frames;
+	ProfileStats stages[PROFILE_STAGE_COUNT];
+	uint16_t framesPerSecond;
+	uint8_t tccr2;
+	uint8_t ocr2;
+} TerminalFrame;
+
+static struct termios savedTermios;
+static bool compareArmed;
+
+/* Handed from the signal handler to the render thread */
+static TerminalFrame frame;
+static sem_t frameReady;
+static bool framePending; /* a frame was run but not taken yet */
+static bool rendering;	  /* the render thread owns the frame, accessed atomically */
+
+/* Only used by the render thread */
+static char output[TERMINAL_BUFFER_SIZE];
+static uint16_t length;
+
+/* Frames per second, counted over the last full second */
+static uint16_t framesPerSecond;
+static uint16_t secondFrames;
+static uint16_t secondStart;  /* ms, wraps around */
+
+static void terminalAppend(const char* format, ...) __attribute__((format(printf, 1, 2)));
+
+static void terminalAppend(const char* format, ...) {
+	va_list args;
+	va_start(args, format);
+	const int count = vsnprintf(&output[length], sizeof(output) - length, format, args);
+	va_end(args);
+	if (count > 0) {
+		length += (uint16_t)count < sizeof(output) - length ? (uint16_t)count : sizeof(output) - length - 1;
+	}
+}
+
+static bool terminalPixel(uint8_t x, uint8_t y) {
+	return x < DISPLAY_WIDTH && y < DISPLAY_HEIGHT && frame.pixels[y][x];
+}
+
+#ifdef TERMINAL_HALF_BLOCKS
+/* One character shows two pixels on top of each other */
+static void terminalRenderPanel() {
+	static const char* const blocks[4] = {" ", "▀", "▄", "█"};  /* none, upper, lower, both */
+
+	for (uint8_t y = 0; y < DISPLAY_HEIGHT; y += 2) {
+		for (uint8_t x = 0; x < DISPLAY_WIDTH; ++x) {
+			terminalAppend("%s", blocks[terminalPixel(x, y) | terminalPixel(x, y + 1) << 1]);
+		}
+		terminalAppend("\x1b[K\r\n");
+	}
+}
+#else
+/* One braille character shows 2 x 4 pixels */
+static void terminalRenderPanel() {
+	/* dot bits of the pattern, by row and column inside the character */
+	static const uint8_t dots[4][2] = {{0x01, 0x08}, {0x02, 0x10}, {0x04, 0x20}, {0x40, 0x80}};
+
+	for (uint8_t y = 0; y < DISPLAY_HEIGHT; y += 4) {
+		for (uint8_t x = 0; x < DISPLAY_WIDTH; x += 2) {
+			uint8_t pattern = 0;
+			for (uint8_t row = 0; row < 4; ++row) {
+				for (uint8_t col = 0; col < 2; ++col) {
+					if (terminalPixel(x + col, y + row)) {
+						pattern |= dots[row][col];
+					}
+				}
+			}
+			/* U+2800 + pattern in UTF-8 */
+			terminalAppend("\xe2%c%c", 0xA0 | pattern >> 6, 0x80 | (pattern & 0x3F));
+		}
+		terminalAppend("\x1b[K\r\n");
+	}
+}
+#endif
+
+static void terminalRenderStatus() {
+	const FrameTimerStats* frames = &frame.frames;
+	terminalAppend("\x1b[K\r\n%u fps  frames %u  missed %u  max delay %lu us\x1b[K\r\n", frame.framesPerSecond, frames->frames,
+				   frames->missedFrames, (unsigned long)TERMINAL_TICKS_TO_US(frames->maxDelay));
+
+	terminalAppend("%-15s %6s %6s %6s us\x1b[K\r\n", "stage", "last", "avg", "max");
+	for (uint8_t i = 0; i < PROFILE_STAGE_COUNT; ++i) {
+		const ProfileStats* stats = &frame.stages[i];
+		const uint32_t average = stats->count ? stats->total / stats->count : 0;
+		terminalAppend("%-15s %6lu %6lu %6lu\x1b[K\r\n", stageNames[i], (unsigned long)TERMINAL_TICKS_TO_US(stats->last),
+					   (unsigned long)TERMINAL_TICKS_TO_US(average), (unsigned long)TERMINAL_TICKS_TO_US(stats->max));
+	}
+
+	if (frame.tccr2 != 0) {
+		terminalAppend("tone %lu Hz\x1b[K\r\n", F_CPU / (2UL * SOUND_PRESCALER * (frame.ocr2 + 1UL)));
+	} else {
+		terminalAppend("tone off\x1b[K\r\n");
+	}
+	terminalAppend("a/d or arrows: move  s/space/down: stop  q: quit\x1b[K");
+}
+
+static void terminalRender() {
+	length = 0;
+	terminalAppend("\x1b[H");
+	terminalRenderPanel();
+	terminalRenderStatus();
+
+	const ssize_t written = write(STDOUT_FILENO, output, length);
+	(void)written;
+}
+
+static void* terminalRenderLoop(__attribute__((unused)) void* argument) {
+	while (1) {
+		sem_wait(&frameReady);
+		terminalRender();
+		__atomic_store_n(&rendering, false, __ATOMIC_RELEASE);
+	}
+	return NULL;
+}
+
+/* Called by the signal handler, copies the frame if the render thread is done with the previous one */
+static void terminalPostFrame() {
+	if (!framePending || __atomic_load_n(&rendering, __ATOMIC_ACQUIRE)) {
+		return;
+	}
+	for (uint8_t y = 0; y < DISPLAY_HEIGHT; ++y) {
+		for (uint8_t x = 0; x < DISPLAY_WIDTH; ++x) {
+			uint8_t panelX, panelY;
+			panelPosition(x, y, &panelX, &panelY);
+			frame.pixels[y][x] = sh1106EmuPixel(panelX, panelY);
+		}
+	}
+	frame.frames = *frameTimerStats();
+	for (uint8_t i = 0; i < PROFILE_STAGE_COUNT; ++i) {
+		frame.stages[i] = *profileStats(i);
+	}
+	frame.framesPerSecond = framesPerSecond;
+	frame.tccr2 = TCCR2;
+	frame.ocr2 = OCR2;
+
+	framePending = false;
+	rendering = true;
+	sem_post(&frameReady);
+}
+
+static void terminalCountFrame() {
+	/* Timer1 wraps around too early for a second */
+	struct timespec now;
+	clock_gettime(CLOCK_MONOTONIC, &now);
+	const uint16_t ms = (uint16_t)(now.tv_sec * 1000 + now.tv_nsec / 1000000);
+
+	secondFrames++;
+	if ((uint16_t)(ms - secondStart) >= 1000) {
+		framesPerSecond = secondFrames;
+		secondFrames = 0;
+		secondStart = ms;
+	}
+}
+
+/* Raises the frame interrupt at the Timer1 compare value, or polls the keyboard while it is disabled */
+static void terminalArm() {
+	uint32_t wait = TERMINAL_IDLE_US;
+	compareArmed = BIT_IS_SET(TIMSK, OCIE1A);
+	if (compareArmed) {
+		wait = TERMINAL_TICKS_TO_US((uint16_t)(OCR1A - TCNT1));
+		if (wait == 0) {
+			wait = 1;  /* 0 would disarm the timer */
+		}
+	}
+	const struct itimerval timer = {.it_value = {.tv_sec = wait / 1000000, .tv_usec = wait % 1000000}};
+	setitimer(ITIMER_REAL, &timer, NULL);
+}
+
+static void terminalStop(__attribute__((unused)) int signal) {
+	tcsetattr(STDIN_FILENO, TCSANOW, &savedTermios);
+	static const char restore[] = "\x1b[?25h\x1b[?1049l";  /* show the cursor, leave the alternate screen */
+	const ssize_t written = write(STDOUT_FILENO, restore, sizeof(restore) - 1);
+	(void)written;
+	_exit(0);
+}
+
+static void terminalTick(__attribute__((unused)) int signal) {
+	if (!keyboardPoll()) {
+		terminalStop(0);
+	}
+	/* The panel only changes in the frame interrupt, the last frame stays on the screen when the game is over */
+	if (compareArmed && BIT_IS_SET(TIMSK, OCIE1A)) {
+		TIMER1_COMPA_vect();
+		terminalCountFrame();
+		framePending = true;
+	}
+	terminalPostFrame();
+	terminalArm();
+}
+
+/* Runs before main() of the game, which starts the frame timer and then waits in its event loop */
+__attribute__((constructor)) static void terminalStart() {
+	tcgetattr(STDIN_FILENO, &savedTermios);
+	struct termios raw = savedTermios;
+	raw.c_lflag &= ~(ICANON | ECHO);  /* Ctrl+C still raises SIGINT */
+	raw.c_cc[VMIN] = 0;				  /* reads return immediately */
+	raw.c_cc[VTIME] = 0;
+	tcsetattr(STDIN_FILENO, TCSANOW, &raw);
+
+	static const char setup[] = "\x1b[?1049h\x1b[?25l\x1b[2J";  /* alternate screen, hide the cursor, clear */
+	const ssize_t written = write(STDOUT_FILENO, setup, sizeof(setup) - 1);
+	(void)written;
+
+	/* The signals are handled by the thread of the game, the render thread blocks them */
+	sem_init(&frameReady, 0, 0);
+	sigset_t all, previous;
+	sigfillset(&all);
+	pthread_sigmask(SIG_SETMASK, &all, &previous);
+	pthread_t renderThread;
+	pthread_create(&renderThread, NULL, terminalRenderLoop, NULL);
+	pthread_sigmask(SIG_SETMASK, &previous, NULL);
+
+	struct sigaction action = {.sa_handler = terminalStop};
+	sigaction(SIGINT, &action, NULL);
+	sigaction(SIGTERM, &action, NULL);
+	action.sa_handler = terminalTick;
+	action.sa_flags = SA_RESTART;
+	sigaction(SIGALRM, &action, NULL);
+
+	terminalArm();
+}
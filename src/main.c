@@ -1,117 +1,345 @@
 
 #include <avr/interrupt.h>
 #include <avr/io.h>
+#include <avr/pgmspace.h>
 #include <math.h>
 #include <stdbool.h>
+#include <stdint.h>
 #include <stdlib.h>
 
 #include "bit.h"
 #include "joystick.h"
 #include "utils/disp/display.h"
+#include "utils/disp/displaybench.h"
+#include "utils/disp/displaytelemetry.h"
+#include "utils/eepromstore.h"
+#include "utils/eventqueue.h"
+#include "utils/frametimer.h"
 #include "utils/math.h"
+#include "utils/profile.h"
+#include "utils/sound.h"
+
+#if !DISPLAY_TRANSPOSED
+#error "The game is laid out for a portrait display, set DISPLAY_ORIENTATION to 90 or 270"
+#endif
 
 #define PLAYER_LIFES_START 3  // Initial number of lifes the player has
-#define LIFE_BAR_WIDTH 5
+#define LIFE_BAR_HEIGHT 5
 
 #define PLATFORM_SIZE 15	// width of the platform in pixels
 #define BALL_SIZE 2			// width and height of the ball in pixels
-#define BALL_VELOCITY 2.5f	// Speed in pixels per update
+// Speeds in pixels per second, scaled to pixels per update with the frame rate
+#define BALL_VELOCITY (75.0f / FRAME_RATE)
+#define PLATFORM_VELOCITY (75.0f / FRAME_RATE)	// maximum speed at full joystick deflection
 
-#define BLOCKS_ROWS 4
-#define BLOCKS_COLUMNS 8
-#define BLOCK_HEIGHT ((DISPLAY_HEIGHT - 2) / BLOCKS_ROWS)  // -2 for wall on the top and bottom
-#define BLOCK_WIDTH (BLOCK_HEIGHT / 2)
+#define BLOCKS_COLUMNS 4
+#define BLOCK_WIDTH ((DISPLAY_WIDTH - 2) / BLOCKS_COLUMNS)	// -2 for wall on the left and right
+#define BLOCK_HEIGHT (BLOCK_WIDTH / 2)
 
 // Because the display width may not be evenly divisible by the number of blocks,
 // a gap might be present at the right edge of the display.
 // This Gap will be walled off and does not count as part of the area where the player can play.
-#define PLAYAREA_HEIGHT (BLOCK_HEIGHT * BLOCKS_ROWS)
-#define PLAYAREA_WIDTH (DISPLAY_WIDTH - LIFE_BAR_WIDTH - 2)
+// Below the life bar and the top wall, the play area reaches down to the bottom of the display.
+#define PLAYAREA_LEFT 1
+#define PLAYAREA_TOP (LIFE_BAR_HEIGHT + 2)
+#define PLAYAREA_WIDTH (BLOCK_WIDTH * BLOCKS_COLUMNS)
+#define PLAYAREA_HEIGHT (DISPLAY_HEIGHT - PLAYAREA_TOP)
+#define PLATFORM_Y (PLAYAREA_HEIGHT - 1)  // the platform is in the bottom row of the play area
+
+#ifdef ENDLESS_MODE
+// The wall advances towards the platform and new rows move in at the top. The block store is
+// a ring of as many rows as fit above the free space, a row falling out of it at the bottom
+// costs a life if it still has alive blocks.
+#define BLOCKS_ROWS ((PLAYAREA_HEIGHT - ENDLESS_FREE_HEIGHT) / BLOCK_HEIGHT)
+#define ENDLESS_FREE_HEIGHT (3 * BLOCK_HEIGHT)	// space above the platform which the wall never enters
+#define ENDLESS_START_ROWS 4
+#define ENDLESS_SCROLL_FRAMES FRAMES_FROM_MS(400)  // the wall moves down one pixel every 400 ms
+#ifndef ENDLESS_SEED
+#define ENDLESS_SEED 0xACE1	 // the same seed generates the same walls, must not be 0
+#endif
+#else
+#define BLOCKS_ROWS 8
+#endif
+
+#define SCORE_PER_BLOCK 10
+#define HIGHSCORE_COUNT 4
+
+#define SAVE_INTERVAL_FRAMES (5 * FRAME_RATE)  // the running game is saved every 5 seconds
+#define SAVE_FIXED_POINT_ONE 128  // positions and speeds are saved as 16 bit fixed point numbers with 7 fractional bits
+#define SAVE_BLOCKS (8 * BLOCKS_COLUMNS)  // blocks of the classic wall, the record has the same layout in both modes
+
+// Sound effects, durations are given in frames
+static const SoundNote soundBrickHit[] PROGMEM = {
+	{SOUND_NOTE_HZ(1568), FRAMES_FROM_MS(33)}, {SOUND_NOTE_HZ(2093), FRAMES_FROM_MS(50)}, SOUND_END};
+static const SoundNote soundPaddleBounce[] PROGMEM = {{SOUND_NOTE_HZ(784), FRAMES_FROM_MS(50)}, SOUND_END};
+static const SoundNote soundLifeLost[] PROGMEM = {
+	{SOUND_NOTE_HZ(523), FRAMES_FROM_MS(100)}, {SOUND_NOTE_HZ(392), FRAMES_FROM_MS(100)}, {SOUND_NOTE_HZ(262), FRAMES_FROM_MS(200)}, SOUND_END};
+
+// Events published by the frame interrupt and handled by the main loop, so that their consumers
+// don't add to the frame time. The input is not an event, the platform has to react in the same frame.
+typedef enum {
+	GAME_EVENT_BRICK_HIT,
+	GAME_EVENT_PADDLE_BOUNCE,
+	GAME_EVENT_LIFE_LOST
+} GameEventType;
+
+typedef struct {
+	uint8_t type;	// GameEventType
+	uint8_t value;	// brick hit: row * BLOCKS_COLUMNS + column, life lost: remaining lifes
+} GameEvent;
+
+#define GAME_EVENTS_PER_FRAME 4	 // at most this many events are handled per frame
+
+EVENT_QUEUE_DEFINE(gameEvents, GameEvent, 16);
+static volatile uint8_t frameCount;	 // incremented by the frame interrupt, wraps around
+
+void publishEvent(GameEventType type, uint8_t value) {
+	const GameEvent event = {.type = type, .value = value};
+	eventQueuePush(&gameEvents, &event);
+}
 
 // Game state variables
 static bool gameWon = false;
 static bool gameLost = false;
+static bool endScreenShown = false;	 // after it only the sound is played, see gameOverTick()
 
 static uint8_t lifes = PLAYER_LIFES_START;
+#ifndef ENDLESS_MODE
 static uint8_t blockCount = BLOCKS_ROWS * BLOCKS_COLUMNS;
+#endif
+static uint16_t score = 0;
+static uint16_t highScores[HIGHSCORE_COUNT];  // sorted, highest first
+static uint16_t saveCountdown = SAVE_INTERVAL_FRAMES;
 
-static float platformY = (PLAYAREA_HEIGHT - PLATFORM_SIZE) / 2.0f;	// Start in the middle of the play area
+// Positions are relative to the play area
+static float platformX = (PLAYAREA_WIDTH - PLATFORM_SIZE) / 2.0f;  // Start in the middle of the play area
 static float ballX;
 static float ballY;
 static float ballSpeedX;
 static float ballSpeedY;
 
 void initBall() {
-	ballX = 1;
-	ballY = platformY + PLATFORM_SIZE / 2.0f - BALL_SIZE / 2.0f;  // Start in the middle of the platform
-	ballSpeedX = BALL_VELOCITY;
-	ballSpeedY = 0;
+	ballX = platformX + PLATFORM_SIZE / 2.0f - BALL_SIZE / 2.0f;  // Start in the middle of the platform
+	ballY = PLATFORM_Y - BALL_SIZE;
+	ballSpeedX = 0;
+	ballSpeedY = -BALL_VELOCITY;
 }
 
 static bool blocks[BLOCKS_ROWS][BLOCKS_COLUMNS];  // true means alive, false means hit
 
+// The block store is a ring buffer: row 0 of the wall is stored at index blocksFirstRow.
+// Without ENDLESS_MODE both stay 0.
+static uint8_t blocksFirstRow = 0;
+static int8_t blocksTop = 0;  // y of the top row in the play area, negative while it moves in under the top wall
+
+// Every block is drawn as a rectangle outline spanning BLOCK_HEIGHT - 1 rows.
+// Since a block row covers the whole play area width, each of its pixel rows is just
+// the combination of the alive blocks in it: the outer pixel rows contain the top/bottom
+// edges, the inner ones only the left and right edges.
+// Both masks are kept ready per block row and only patched when a block is destroyed.
+static uint64_t blockEdgeMasks[BLOCKS_ROWS];
+static uint64_t blockInnerMasks[BLOCKS_ROWS];
+
+static inline uint64_t blockEdgeMask(uint8_t col) {
+	return ((1ull << (BLOCK_WIDTH - 1)) - 1) << (col * BLOCK_WIDTH + PLAYAREA_LEFT);
+}
+
+static inline uint64_t blockInnerMask(uint8_t col) {
+	return (1ull << (col * BLOCK_WIDTH + PLAYAREA_LEFT)) | (1ull << (col * BLOCK_WIDTH + PLAYAREA_LEFT + BLOCK_WIDTH - 2));
+}
+
+// Index of a row of the wall in the block store
+static inline uint8_t blockIndex(uint8_t row) {
+	row += blocksFirstRow;
+	return row < BLOCKS_ROWS ? row : row - BLOCKS_ROWS;
+}
+
+// Sets the blocks of the row at the given store index, bit col of alive is set for an alive block
+void setBlockRow(uint8_t index, uint8_t alive) {
+	blockEdgeMasks[index] = 0;
+	blockInnerMasks[index] = 0;
+	for (uint8_t col = 0; col < BLOCKS_COLUMNS; col++) {
+		blocks[index][col] = BIT_IS_SET(alive, col);
+		if (blocks[index][col]) {
+			blockEdgeMasks[index] |= blockEdgeMask(col);
+			blockInnerMasks[index] |= blockInnerMask(col);
+		}
+	}
+}
+
+#ifdef ENDLESS_MODE
+static uint16_t randomState = ENDLESS_SEED;
+static uint8_t scrollCountdown = ENDLESS_SCROLL_FRAMES;
+
+// xorshift PRNG with a period of 2^16 - 1
+uint16_t nextRandom() {
+	randomState ^= randomState << 7;
+	randomState ^= randomState >> 9;
+	randomState ^= randomState << 8;
+	return randomState;
+}
+
+void generateBlockRow(uint8_t index) {
+	uint8_t alive = nextRandom() >> (16 - BLOCKS_COLUMNS);  // the high bits are the most random
+	if (alive == 0) {
+		alive = BIT(nextRandom() % BLOCKS_COLUMNS);	 // no empty rows
+	}
+	setBlockRow(index, alive);
+}
+
+void initBlocks() {
+	blocksFirstRow = 0;
+	blocksTop = 0;
+	for (uint8_t row = 0; row < BLOCKS_ROWS; row++) {
+		if (row < ENDLESS_START_ROWS) {
+			generateBlockRow(row);
+		} else {
+			setBlockRow(row, 0);
+		}
+	}
+}
+
+// Moves the wall down, the cost is the same for every frame: the blocks are drawn at an offset,
+// and a new row only replaces the bottom row in the ring.
+// @return false if the last life was lost because the wall reached the platform
+bool scrollBlocks() {
+	if (--scrollCountdown != 0) {
+		return true;
+	}
+	scrollCountdown = ENDLESS_SCROLL_FRAMES;
+
+	if (++blocksTop <= 0) {
+		return true;
+	}
+	// There is a gap above the top row, the bottom row is recycled for a new top row
+	const uint8_t last = blockIndex(BLOCKS_ROWS - 1);
+	const bool reached = blockEdgeMasks[last] != 0;
+	blocksFirstRow = last;
+	blocksTop -= BLOCK_HEIGHT;
+	generateBlockRow(last);
+
+	if (reached) {
+		lifes--;
+		publishEvent(GAME_EVENT_LIFE_LOST, lifes);
+		if (lifes == 0) {
+			gameLost = true;
+			return false;
+		}
+	}
+	return true;
+}
+#else
 void initBlocks() {
 	for (uint8_t row = 0; row < BLOCKS_ROWS; row++) {
-		for (uint8_t col = 0; col < BLOCKS_COLUMNS; col++) {
-			blocks[row][col] = true;  // All blocks are initially alive
+		setBlockRow(row, BIT(BLOCKS_COLUMNS) - 1);	// All blocks are initially alive
+	}
+}
+#endif
+
+void destroyBlock(uint8_t row, uint8_t col) {
+	const uint8_t index = blockIndex(row);
+	blocks[index][col] = false;
+	blockEdgeMasks[index] &= ~blockEdgeMask(col);
+	blockInnerMasks[index] &= ~blockInnerMask(col);
+}
+
+void drawBlocks() {
+	uint8_t y = PLAYAREA_TOP + blocksTop;
+
+	for (uint8_t row = 0; row < BLOCKS_ROWS; row++) {
+		const uint8_t index = blockIndex(row);
+		const uint64_t edges = blockEdgeMasks[index];
+		const uint64_t inner = blockInnerMasks[index];
+
+		for (uint8_t i = 0; i < BLOCK_HEIGHT - 1; i++, y++) {
+			if (y < PLAYAREA_TOP) {
+				continue;  // still hidden by the top wall
+			}
+			displayDrawRowMask(y, (i == 0 || i == BLOCK_HEIGHT - 2) ? edges : inner);
 		}
+		y++;  // gap between the blocks
 	}
 }
 
+// Moves the ball and handles the collisions with the walls and blocks.
+// The platform depends on the input and is updated later by gameUpdatePlatform().
 void gameUpdate() {
-	// parallelize joystick reading
+	// The loss is only detected in gameDraw(), so this frame just shows the end screen.
+	// Without it an endless run could lose another life to the wall and wrap lifes.
+	if (gameWon || gameLost) {
+		return;
+	}
+
+	// parallelize joystick reading, the result is read as late as possible
 	requestJoystickUpdate();
 
+#ifdef ENDLESS_MODE
+	if (!scrollBlocks()) {
+		return;
+	}
+#endif
+
 	// Update ball position
 	ballX += ballSpeedX;
 	ballY += ballSpeedY;
 
 	// Check for wall collisions
+	if (ballX < 0) {
+		ballX = 0;
+		ballSpeedX = -ballSpeedX;  // Bounce off left wall
+	} else if (ballX > PLAYAREA_WIDTH - BALL_SIZE) {
+		ballX = PLAYAREA_WIDTH - BALL_SIZE;
+		ballSpeedX = -ballSpeedX;  // Bounce off right wall
+	}
 	if (ballY < 0) {
 		ballY = 0;
 		ballSpeedY = -ballSpeedY;  // Bounce off top wall
-	} else if (ballY > PLAYAREA_HEIGHT - BALL_SIZE) {
-		ballY = PLAYAREA_HEIGHT - BALL_SIZE;
-		ballSpeedY = -ballSpeedY;  // Bounce off bottom wall
 	}
 
 	// limit the area where we search for block collisions
-	int8_t startCol = (int8_t)floor((ballX - (PLAYAREA_WIDTH - BLOCKS_COLUMNS * BLOCK_WIDTH)) / BLOCK_WIDTH);
+	int8_t startCol = (int8_t)floor(ballX / BLOCK_WIDTH);
 	if (startCol < 0) {
 		startCol = 0;
 	}
-	int8_t endCol = (int8_t)floor((ballX + BALL_SIZE - (PLAYAREA_WIDTH - BLOCKS_COLUMNS * BLOCK_WIDTH)) / BLOCK_WIDTH);
+	int8_t endCol = (int8_t)floor((ballX + BALL_SIZE) / BLOCK_WIDTH);
 	if (endCol >= BLOCKS_COLUMNS) {
 		endCol = BLOCKS_COLUMNS - 1;
 	}
-	int8_t startRow = (int8_t)floor(ballY / BLOCK_HEIGHT);
+	int8_t startRow = (int8_t)floor((ballY - blocksTop) / BLOCK_HEIGHT);
 	if (startRow < 0) {
 		startRow = 0;
 	}
-	int8_t endRow = (int8_t)floor((ballY + BALL_SIZE) / BLOCK_HEIGHT);
+	int8_t endRow = (int8_t)floor((ballY + BALL_SIZE - blocksTop) / BLOCK_HEIGHT);
 	if (endRow >= BLOCKS_ROWS) {
 		endRow = BLOCKS_ROWS - 1;
 	}
 	// Check for block collisions
 	for (uint8_t row = startRow; row <= endRow; row++) {
+		const int16_t blockY = row * BLOCK_HEIGHT + blocksTop;
+		if (blockY + BLOCK_HEIGHT - 2 < 0) {
+			continue;  // the whole row is still hidden by the top wall, see drawBlocks()
+		}
 		for (uint8_t col = startCol; col <= endCol; col++) {
-			if (!blocks[row][col]) {
+			if (!blocks[blockIndex(row)][col]) {
 				continue;
 			}
-			uint8_t blockX = col * BLOCK_WIDTH + PLAYAREA_WIDTH - BLOCKS_COLUMNS * BLOCK_WIDTH;
-			uint8_t blockY = row * BLOCK_HEIGHT;
+			uint8_t blockX = col * BLOCK_WIDTH;
 
 			if (ballX + BALL_SIZE < blockX || ballX > blockX + BLOCK_WIDTH ||
 				ballY + BALL_SIZE < blockY || ballY > blockY + BLOCK_HEIGHT) {
 				continue;  // No collision with this block
 			}
 
-			blocks[row][col] = false;  // Mark block as hit
+			destroyBlock(row, col);	 // Mark block as hit
+			publishEvent(GAME_EVENT_BRICK_HIT, row * BLOCKS_COLUMNS + col);
+			score = (score > UINT16_MAX - SCORE_PER_BLOCK) ? UINT16_MAX : score + SCORE_PER_BLOCK;  // an endless run has no upper bound
+#ifndef ENDLESS_MODE
 			blockCount--;
 			if (blockCount == 0) {
 				gameWon = true;	 // All blocks hit, player won
 				return;
 			}
+#endif
 
 			// We calculate the anmount of overlap in both x and y direction
 			// The smaller overlap will always be the direction of the bounce
@@ -150,122 +378,355 @@ void gameUpdate() {
 			}
 		}
 	}
+}
 
+// Reads the joystick, moves the platform and lets the ball bounce off it (or get lost).
+void gameUpdatePlatform() {
 	// Read joystick input
 	float jy = (float)joystickRead();
 	// Center the joystick value around 0
 	jy -= 512.0f;
 	// only move the platform if the joystick is not in deadzone
 	if (abs(jy) > 80.0f) {
-		jy /= (512.0f / 2.5f);	// Scale the joystick value to a range of -4 to 4
-
-		// Update platform position
-		platformY += jy;
-		if (platformY < 0) {
-			platformY = 0;
-		} else if (platformY > PLAYAREA_HEIGHT - PLATFORM_SIZE - 1) {
-			platformY = PLAYAREA_HEIGHT - PLATFORM_SIZE - 1;
+		jy /= (512.0f / PLATFORM_VELOCITY);	 // Scale the joystick value to the platform speed
+
+		// Update platform position (the joystick is rotated with the display)
+		platformX += jy;
+		if (platformX < 0) {
+			platformX = 0;
+		} else if (platformX > PLAYAREA_WIDTH - PLATFORM_SIZE - 1) {
+			platformX = PLAYAREA_WIDTH - PLATFORM_SIZE - 1;
 		}
 	}
 
 	// Check for platform collisions
-	if (ballX < 1) {
+	if (ballY > PLATFORM_Y - BALL_SIZE) {
 		// -1 / +1 to give a bit more leeway on the platform
-		if (ballY + BALL_SIZE >= platformY - 2 && ballY <= platformY + PLATFORM_SIZE + 2) {
+		if (ballX + BALL_SIZE >= platformX - 2 && ballX <= platformX + PLATFORM_SIZE + 2) {
 			// Bounce off platform
-			ballX = 1;
+			ballY = PLATFORM_Y - BALL_SIZE;
 			// calculate rebound angle
-			float rad = -(platformY + PLATFORM_SIZE / 2.0f - ballY + BALL_SIZE / 2.0f);
+			float rad = -(platformX + PLATFORM_SIZE / 2.0f - ballX + BALL_SIZE / 2.0f);
 			rad /= ((PLATFORM_SIZE + 4) / 2.0f);		  // Normalized to -1 to 1 (added 4 because of the leeway)
 			rad *= (M_PI * 0.4f);						  // Scaled to a reasonable angle range
 			rad = clamp(rad, -M_PI / 3.3f, M_PI / 3.3f);  // Clamp to prevent too steep angles
 			// calculate new speed based on rebound angle
-			ballSpeedX = BALL_VELOCITY * cos(rad);
-			ballSpeedY = BALL_VELOCITY * sin(rad);
+			ballSpeedX = BALL_VELOCITY * sin(rad);
+			ballSpeedY = -BALL_VELOCITY * cos(rad);
+			publishEvent(GAME_EVENT_PADDLE_BOUNCE, 0);
 		}
 	}
-	if (ballX < 0) {
-		// Ball is out of bounds on the left side
+	if (ballY > PLAYAREA_HEIGHT - BALL_SIZE) {
+		// Ball is out of bounds at the bottom
 		lifes--;
+		publishEvent(GAME_EVENT_LIFE_LOST, lifes);
 		if (lifes == 0) {
 			gameLost = true;
 			return;
 		}
 		initBall();	 // Reset ball
-	} else if (ballX > PLAYAREA_WIDTH - BALL_SIZE) {
-		ballX = PLAYAREA_WIDTH - BALL_SIZE;
-		ballSpeedX = -ballSpeedX;  // Bounce off right wall
+	}
+}
+
+// Everything needed to resume a game, stored in the EEPROM together with the high scores.
+// An endless run can't be resumed, the wall and the PRNG state don't fit into the record. Only the high scores are kept,
+// the blocks are unused and the lifes are 0, so a record of either mode can be loaded by the other one.
+// Packed, so the host (src/host/terminal/eepromfile.c) stores the same 25 bytes as the AVR instead of padding the score.
+typedef struct __attribute__((packed)) {
+	uint8_t blocks[(SAVE_BLOCKS + 7) / 8];	// alive blocks, bit row * BLOCKS_COLUMNS + col
+	int16_t platformX;
+	int16_t ballX;
+	int16_t ballY;
+	int16_t ballSpeedX;
+	int16_t ballSpeedY;
+	uint8_t lifes;	// 0 if the game is over, a new one is started after a reset
+	uint16_t score;
+	uint16_t highScores[HIGHSCORE_COUNT];
+} SaveGame;
+
+_Static_assert(sizeof(SaveGame) == 25, "The SaveGame layout changed, saved games would be loaded wrongly");
+_Static_assert(sizeof(SaveGame) <= EEPROM_STORE_PAYLOAD_SIZE, "SaveGame does not fit into an EEPROM record");
+#ifndef ENDLESS_MODE
+_Static_assert(BLOCKS_ROWS * BLOCKS_COLUMNS == SAVE_BLOCKS, "The saved blocks don't match the wall");
+#endif
+
+static inline int16_t toFixedPoint(float value) {
+	return (int16_t)(value * SAVE_FIXED_POINT_ONE);
+}
+
+static inline float fromFixedPoint(int16_t value) {
+	return (float)value / SAVE_FIXED_POINT_ONE;
+}
+
+void saveGame() {
+	SaveGame save = {
+		.platformX = toFixedPoint(platformX),
+		.ballX = toFixedPoint(ballX),
+		.ballY = toFixedPoint(ballY),
+		.ballSpeedX = toFixedPoint(ballSpeedX),
+		.ballSpeedY = toFixedPoint(ballSpeedY),
+#ifdef ENDLESS_MODE
+		.lifes = 0,
+#else
+		.lifes = (gameWon || gameLost) ? 0 : lifes,
+#endif
+		.score = score,
+	};
+#ifndef ENDLESS_MODE
+	for (uint8_t i = 0; i < BLOCKS_ROWS * BLOCKS_COLUMNS; i++) {
+		if (blocks[i / BLOCKS_COLUMNS][i % BLOCKS_COLUMNS]) {
+			BIT_SET(save.blocks[i / 8], i % 8);
+		}
+	}
+#endif
+	for (uint8_t i = 0; i < HIGHSCORE_COUNT; i++) {
+		save.highScores[i] = highScores[i];
+	}
+	eepromStoreWrite(&save, sizeof(save));
+}
+
+// Must be called after initBlocks() and initBall(), so that a new game is started if there is nothing to resume
+void loadGame() {
+	SaveGame save;
+	if (!eepromStoreLoad(&save, sizeof(save))) {
+		return;
+	}
+	for (uint8_t i = 0; i < HIGHSCORE_COUNT; i++) {
+		highScores[i] = save.highScores[i];
+	}
+	// Only a classic game is resumed, an endless build just takes the high scores out of a classic record
+#ifndef ENDLESS_MODE
+	if (save.lifes == 0) {
+		return;
+	}
+
+	for (uint8_t i = 0; i < BLOCKS_ROWS * BLOCKS_COLUMNS; i++) {
+		if (!BIT_IS_SET(save.blocks[i / 8], i % 8)) {
+			destroyBlock(i / BLOCKS_COLUMNS, i % BLOCKS_COLUMNS);
+			blockCount--;
+		}
+	}
+	platformX = fromFixedPoint(save.platformX);
+	ballX = fromFixedPoint(save.ballX);
+	ballY = fromFixedPoint(save.ballY);
+	ballSpeedX = fromFixedPoint(save.ballSpeedX);
+	ballSpeedY = fromFixedPoint(save.ballSpeedY);
+	lifes = save.lifes;
+	score = save.score;
+#endif
+}
+
+void autosaveGame() {
+	if (--saveCountdown == 0) {
+		saveCountdown = SAVE_INTERVAL_FRAMES;
+		saveGame();
+	}
+}
+
+void insertHighScore() {
+	for (uint8_t i = 0; i < HIGHSCORE_COUNT; i++) {
+		if (score > highScores[i]) {
+			for (uint8_t j = HIGHSCORE_COUNT - 1; j > i; j--) {
+				highScores[j] = highScores[j - 1];
+			}
+			highScores[i] = score;
+			return;
+		}
 	}
 }
 
 void gameDraw() {
+	profileBegin(PROFILE_STAGE_DRAW);
 	displayClearBuffer();
 
 	if (gameWon || gameLost) {
 		if (gameWon) {
-			displayRenderTextVertical(DISPLAY_WIDTH / 2 + 7, 19, "You");
-			displayRenderTextVertical(DISPLAY_WIDTH / 2 - 7, 15, "Won!");
+			displayRenderText((DISPLAY_WIDTH - 3 * 8) / 2, DISPLAY_HEIGHT / 2 - 10, "You");
+			displayRenderText((DISPLAY_WIDTH - 4 * 8) / 2, DISPLAY_HEIGHT / 2 + 2, "Won!");
 		} else {
-			displayRenderTextVertical(DISPLAY_WIDTH / 2 + 7, 15, "Game");
-			displayRenderTextVertical(DISPLAY_WIDTH / 2 - 7, 11, "Over!");
+			displayRenderText((DISPLAY_WIDTH - 4 * 8) / 2, DISPLAY_HEIGHT / 2 - 10, "Game");
+			displayRenderText((DISPLAY_WIDTH - 5 * 8) / 2, DISPLAY_HEIGHT / 2 + 2, "Over!");
 		}
 
-		displayUpdate();
+		insertHighScore();
+		saveGame();
 
-		// disable further updates
-		cli();
+		displayPrint(0, DISPLAY_HEIGHT / 2 + 20, "Pts %u", score);
+		displayPrint(0, DISPLAY_HEIGHT / 2 + 32, "Top %u", highScores[0]);
+		displayUpdate();
 
+		// the frame interrupt keeps running until the last effect is played, see gameOverTick()
+		endScreenShown = true;
 		return;
 	}
 
-	for (uint8_t i = 0; i < lifes; i++) {  // life bar
-		displayDrawFilledRectangle(PLAYAREA_WIDTH + 2, i * PLAYAREA_HEIGHT / PLAYER_LIFES_START, LIFE_BAR_WIDTH, PLAYAREA_HEIGHT / PLAYER_LIFES_START);
+	// Everything which doesn't depend on the input is drawn first
+	displayDrawHorizontalLine(0, PLAYAREA_TOP - 1, PLAYAREA_WIDTH + 2);						// top wall
+	displayDrawVerticalLine(0, PLAYAREA_TOP, PLAYAREA_HEIGHT);								// left wall
+	displayDrawVerticalLine(PLAYAREA_LEFT + PLAYAREA_WIDTH, PLAYAREA_TOP, PLAYAREA_HEIGHT);	// right wall
+
+	drawBlocks();
+	profileEnd(PROFILE_STAGE_DRAW);
+
+	// The ADC conversion started in gameUpdate() is finished by now, so sampling the input doesn't wait
+	profileBegin(PROFILE_STAGE_INPUT_TO_FLUSH);
+	gameUpdatePlatform();
+
+	for (uint8_t i = 0; i < PLAYER_LIFES_START; i++) {	// life bar
+		const uint8_t x = PLAYAREA_LEFT + i * PLAYAREA_WIDTH / PLAYER_LIFES_START;
+#if DISPLAY_GRAY_FLICKER_HZ(FRAME_RATE) >= DISPLAY_GRAY_MIN_FLICKER_HZ
+		// lost lifes are shown in gray
+		displaySetGray(i < lifes ? DISPLAY_GRAY_WHITE : DISPLAY_GRAY_WHITE / 2);
+		displayDrawFilledRectangle(x, 0, PLAYAREA_WIDTH / PLAYER_LIFES_START, LIFE_BAR_HEIGHT);
+#else
+		// gray would flicker at this frame rate, lost lifes are shown as outlines
+		if (i < lifes) {
+			displayDrawFilledRectangle(x, 0, PLAYAREA_WIDTH / PLAYER_LIFES_START, LIFE_BAR_HEIGHT);
+		} else {
+			displayDrawRectangle(x, 0, PLAYAREA_WIDTH / PLAYER_LIFES_START, LIFE_BAR_HEIGHT);
+		}
+#endif
+	}
+	displaySetGray(DISPLAY_GRAY_WHITE);
+
+	const uint8_t platformRow = PLAYAREA_TOP + PLATFORM_Y;
+	const uint8_t ballTop = PLAYAREA_TOP + (uint8_t)ballY;
+	const uint8_t ballBottom = ballTop + BALL_SIZE - 1;
+	displayDrawHorizontalLine(PLAYAREA_LEFT + round(platformX), platformRow, PLATFORM_SIZE);	 // platform
+	displayDrawRectangle(PLAYAREA_LEFT + (uint8_t)ballX, ballTop, BALL_SIZE, BALL_SIZE);	 // ball
+
+	// The rows with the platform and the ball are sent first, they react to the input.
+	// The rest of the display follows; the rows of the ball's old position are part of it.
+	profileBegin(PROFILE_STAGE_FLUSH);
+	displayUpdateRows(platformRow, platformRow);
+	displayUpdateRows(ballTop, ballBottom);
+	profileEnd(PROFILE_STAGE_INPUT_TO_FLUSH);
+
+	if (ballTop > 0) {
+		displayUpdateRows(0, ballTop - 1);
 	}
+	if (ballBottom + 1 < platformRow) {
+		displayUpdateRows(ballBottom + 1, platformRow - 1);
+	}
+	displayEndFrame();
+	profileEnd(PROFILE_STAGE_FLUSH);
+
+	displayTelemetrySendFrame();
+}
 
-	displayDrawRectangle(0, round(platformY) + 1, 1, PLATFORM_SIZE);  // platform
-	displayDrawHorizontalLine(0, 0, PLAYAREA_WIDTH);				  // top wall
-	displayDrawHorizontalLine(0, PLAYAREA_HEIGHT, PLAYAREA_WIDTH);	  // bottom wall
-	displayDrawVerticalLine(PLAYAREA_WIDTH - 1, 0, PLAYAREA_HEIGHT);  // right wall
+// Once the end screen is drawn only the sequencer runs, until the last effect (e.g. the lost life) is played
+void gameOverTick() {
+	static uint8_t idleFrames = 0;
 
-	for (uint8_t row = 0; row < BLOCKS_ROWS; row++) {  // blocks
-		for (uint8_t col = 0; col < BLOCKS_COLUMNS; col++) {
-			if (blocks[row][col]) {
-				displayDrawRectangle(col * BLOCK_WIDTH + PLAYAREA_WIDTH - BLOCKS_COLUMNS * BLOCK_WIDTH, row * BLOCK_HEIGHT + 1, BLOCK_WIDTH - 1, BLOCK_HEIGHT - 1);
-			}
-		}
-	}
+	profileBegin(PROFILE_STAGE_SOUND);
+	soundTick();
+	profileEnd(PROFILE_STAGE_SOUND);
 
-	displayDrawRectangle((uint8_t)ballX, (uint8_t)ballY + 1, BALL_SIZE, BALL_SIZE);	 // ball
+	// The main loop may have taken the event of the effect but not queued the effect yet,
+	// so the sound has to be idle in two frames in a row
+	if (soundBusy() || !eventQueueIsEmpty(&gameEvents)) {
+		idleFrames = 0;
+		return;
+	}
+	if (++idleFrames < 2) {
+		return;
+	}
 
-	displayUpdate();
+	// the sequencer has silenced the piezo, disable further updates.
+	// Only the frame interrupt is disabled, the EEPROM is still written in the background.
+	frameTimerStop();
 }
 
-ISR(TIMER0_COMP_vect) {
+ISR(TIMER1_COMPA_vect) {
+	frameTimerStartFrame();
+	frameCount++;
+
+	if (endScreenShown) {
+		gameOverTick();
+		return;
+	}
+
+	profileBegin(PROFILE_STAGE_UPDATE);
 	gameUpdate();
+	profileEnd(PROFILE_STAGE_UPDATE);
+
+#ifndef ENDLESS_MODE
+	if (!gameWon && !gameLost) {
+		autosaveGame();
+	}
+#endif
+
+	profileBegin(PROFILE_STAGE_SOUND);
+	soundTick();
+	profileEnd(PROFILE_STAGE_SOUND);
+
 	gameDraw();
 }
 
+// Deferred event consumers, called from the main loop with interrupts enabled
+void handleEvent(const GameEvent* event) {
+	switch (event->type) {
+		case GAME_EVENT_BRICK_HIT:
+			soundPlay(soundBrickHit);
+			break;
+		case GAME_EVENT_PADDLE_BOUNCE:
+			soundPlay(soundPaddleBounce);
+			break;
+		case GAME_EVENT_LIFE_LOST:
+			soundPlay(soundLifeLost);
+			break;
+	}
+}
+
 int main() {
 	displaySetup();
+	displayTelemetrySetup();
 	joystickInit();
+	soundSetup();
+	frameTimerSetup();
+	profileInit();
+
+#ifdef PROFILE_ENABLED
+	// results can be inspected with the debugger via displayBenchResults()
+	displayBenchRun();
+#ifdef DISPLAY_BENCH_REPORT
+	// the report waits for the USART interrupt, the frame interrupt isn't enabled yet
+	sei();
+	displayBenchReport();
+#endif
+#endif
 
 	initBlocks();
 	initBall();
+	loadGame();	 // resume the saved game, if there is one
 
-	// Initialize Timer0 for game updates at 60Hz
-	BIT_SET(TCCR0, WGM00);	// Set WGM00 bit for CTC mode
-	BIT_CLR(TCCR0, WGM01);	// Clear WGM01 bit for CTC mode
+	// game updates at FRAME_RATE
+	frameTimerStart();
 
-	// Set Compare Match value
-	OCR0 = (F_CPU / 1024 / 60) - 1;	 // (F_CPU / prescaler / frequency) - 1
-
-	// Enable Timer0 Compare Match Interrupt
-	BIT_SET(TIMSK, OCIE0);
+	sei();
 
-	// Start Timer0 with 1024 prescaler
-	TCCR0 |= (1 << CS02) | (1 << CS00);
+	// waiting for the heatdeath of the universe, handling the events of every frame on the way
+	uint8_t handledFrame = frameCount;
+#ifdef PROFILE_REPORT
+	uint8_t reportFrames = 0;
+#endif
+	while (1) {
+		if (handledFrame == frameCount) {
+			continue;
+		}
+		handledFrame = frameCount;
 
-	sei();
+		GameEvent event;
+		for (uint8_t i = 0; i < GAME_EVENTS_PER_FRAME && eventQueuePop(&gameEvents, &event); i++) {
+			handleEvent(&event);
+		}
 
-	while (1);	// waiting for the heatdeath of the universe
+#ifdef PROFILE_REPORT
+		// about once per second, the events of this frame are handled already
+		if (++reportFrames >= FRAME_RATE) {
+			reportFrames = 0;
+			profileReport();
+		}
+#endif
+	}
 }
@@ -13,259 +13,472 @@
 #include <util/delay.h>
 
 #include "bit.h"
+#include "utils/disp/displaybackend.h"
 #include "utils/disp/font8x8.h"
-#include "utils/disp/font8x8vertical.h"
-#include "utils/math.h"
 #include "utils/spi.h"
 
-#define RESET_PIN PB3
-#define DATA_CMD_PIN PB4
-
-/* Display RAM has 132 columns, while only 128 are visible. Therefore skip the first 2 non-visible columns   */
-#define DISPLAY_NONVISIBLE_BORDER_OFFSET 2
-
 #define DISPLAY_PRINT_TEXT_BUFFER_SIZE 64
 
-typedef enum {
-	SH1106_SET_CONTRAST = 0x81,
-	SH1106_ENTIRE_DISPLAY_ON_DISABLE = 0xA4,
-	SH1106_ENTIRE_DISPLAY_ON = 0xA5,
-	SH1106_NORMAL_DISPLAY = 0xA6,
-	SH1106_REVERSE_DISPLAY = 0xA7,
-	SH1106_SET_DISPLAY_OFF = 0xAE,
-	SH1106_SET_DISPLAY_ON = 0xAF,
-
-	SH1106_SET_DISPLAY_OFFSET = 0xD3,
-	SH1106_SET_COMPINS = 0xDA,
-
-	SH1106_SETVCOMDETECT = 0xDB,
-
-	SH1106_SETDISPLAYCLOCKDIV = 0xD5,
-	SH1106_SETPRECHARGE = 0xD9,
-
-	SH1106_SET_MULTIPLEX_RATIO = 0xA8,
-
-	SH1106_SET_PAGE_COLUMN_MASK = 0x0F,
-	SH1106_SET_PAGE_COLUMN_H = 0x10,
-	SH1106_SET_PAGE_COLUMN_L = 0x00,
-	SH1106_SET_PAGE = 0xB0,
-	SH1106_SETSTARTLINE = 0x40,
-
-	SH1106_SET_ADDRESSING_MODE = 0x20,
-	SH1106_SET_COLUMN_ADDR = 0x21,
-	SH1106_SET_PAGE_ADDR = 0x22,
-
-	SH1106_COMSCANINC = 0xC0,
-	SH1106_COMSCANDEC = 0xC8,
-
-	SH1106_SEGMENT_REMAP = 0xA0,
-
-	SH1106_CHARGEPUMP = 0x8D,
+/* With two panels one axis is 256 pixels long and every uint8_t coordinate lies on it */
+#if DISPLAY_WIDTH > 0xFF
+#define DISPLAY_X_OUTSIDE(x) false
+#else
+#define DISPLAY_X_OUTSIDE(x) ((x) >= DISPLAY_WIDTH)
+#endif
+#if DISPLAY_HEIGHT > 0xFF
+#define DISPLAY_Y_OUTSIDE(y) false
+#else
+#define DISPLAY_Y_OUTSIDE(y) ((y) >= DISPLAY_HEIGHT)
+#endif
+#if DISPLAY_COLUMNS > 0xFF
+#define DISPLAY_COLUMN_OUTSIDE(column) false
+#else
+#define DISPLAY_COLUMN_OUTSIDE(column) ((column) >= DISPLAY_COLUMNS)
+#endif
 
-	SH1106_EXTERNALVCC = 0x1,
-	SH1106_SWITCHCAPVCC = 0x2
-} DisplaySH1106Command;
-
-typedef enum {
-	SH1106_ADDRESSING_MODE_PAGE = 0b10
-} DisplaySH1106AddressingMode;
-
-/** Signal, that the to be transmitted byte is data.
- * This is accomplished by setting th D/C pin HIGH. */
 void displaySetDataIndicator() {
-	BIT_SET(PORTB, DATA_CMD_PIN);
+	BIT_SET(PORTB, DISPLAY_DATA_CMD_PIN);
 }
-/** Signal, that the to be transmitted byte is a command.
- * This is accomplished by setting th D/C pin LOW. */
+
 void displaySetCommandIndicator() {
-	BIT_CLR(PORTB, DATA_CMD_PIN);
+	BIT_CLR(PORTB, DISPLAY_DATA_CMD_PIN);
 }
-/** Send a single-byte command. */
-void displaySendCommand(DisplaySH1106Command cmd) {
+
+void displaySendCommand(uint8_t cmd) {
 	displaySetCommandIndicator();
-	spiTransferByte((uint8_t)cmd);
+	spiTransferByte(cmd);
 }
-/** Send a single data byte. */
+
 void displaySendData(uint8_t data) {
 	displaySetDataIndicator();
 	spiTransferByte(data);
 }
 
-/** Select the addressing mode. For the SH1106 there is only the page-based addressing mode available.
- * The initial SSD1306 also supports a vertical and horizontal addressing mode.
- *
- * @param[in] addressingMode
- */
-void displaySetAddressingMode(DisplaySH1106AddressingMode addressingMode) {
-	spiTransferByte(SH1106_SET_ADDRESSING_MODE | (uint8_t)addressingMode);
-}
-
-/** Before writing to the display RAM, the page and column need to be selected.
- * Each page has a size of 132x8 pixel. In total there are 8 pages stacked
- * on top of each other, realizing 64 pixel display height.
- * A column represents an 8 pixel vertical slice of a page.
- *
- * @param[in] page (value between 0-7)
- * @param[in] startColumn (value between 0-127)
- */
-void displaySelectPageAndStartColumn(uint8_t page, uint8_t startColumn) {
-	const uint8_t nibbleMask = 0b1111;
-	displaySendCommand(SH1106_SET_PAGE | (page & nibbleMask));
-	displaySendCommand(SH1106_SET_PAGE_COLUMN_L | (startColumn & nibbleMask));
-	displaySendCommand(SH1106_SET_PAGE_COLUMN_H | ((startColumn >> 4) & nibbleMask));
-}
-/** By setting the start line (i.e. the upmost pixel row), the first RAM data row can be mapped to a lower pixel row
- *
- * @param[in] start line - the physical pixel row on which the upmost RAM data should appear on
- */
-void displaySetStartLine(uint8_t line) {
-	const uint8_t lineMask = 64 - 1;
-	displaySendCommand(SH1106_SETSTARTLINE | (line & lineMask));
-}
-
-/** Set the display brightness/contrast. Default value ist 128.
- *
- * @param[in] contrast value (value range 0 - 255)
- */
-void displaySetContrast(uint8_t contrast) {
-	displaySendCommand(SH1106_SET_CONTRAST);
-	displaySendCommand(contrast);
-}
-
-/** Carry out a display hardware reset, by toggling the RESET_PIN */
+/** Carry out a display hardware reset, by toggling the DISPLAY_RESET_PIN */
 void displayReset() {
 	/* The SSD1306 manual states a required delay of 3 us - we are a bit more generous */
-	BIT_SET(PORTB, RESET_PIN);
+	BIT_SET(PORTB, DISPLAY_RESET_PIN);
 	_delay_ms(1);
-	BIT_CLR(PORTB, RESET_PIN);
+	BIT_CLR(PORTB, DISPLAY_RESET_PIN);
 	_delay_ms(1);
-	BIT_SET(PORTB, RESET_PIN);
+	BIT_SET(PORTB, DISPLAY_RESET_PIN);
 	_delay_ms(1);
 }
 
+#if DISPLAY_PANELS > 1
+static const uint8_t panelChipSelectPins[] = DISPLAY_CS_PINS;
+/* Bit per panel whose framebuffer part may differ from its display RAM. Set by everything which
+ * writes into the framebuffer, panels without the bit are skipped by all transfers. */
+static uint8_t panelsDirty;
+/* Bit per panel which was drawn on since the last displayClearBuffer(), only these change by clearing */
+static uint8_t panelsDrawn;
+
+/** Mark the panels of the framebuffer columns first - last (inclusive) as changed */
+static inline void displayMarkColumns(uint8_t first, uint8_t last) {
+	const uint8_t panels = BIT(last / DISPLAY_PANEL_WIDTH + 1) - BIT(first / DISPLAY_PANEL_WIDTH);
+	panelsDrawn |= panels;
+	panelsDirty |= panels;
+}
+
+/** Select the panel showing the given framebuffer slice (or all panels with DISPLAY_PANELS as argument)
+ * for the following transfers. If the controllers mirror the columns, the panel order is reversed as well. */
+static void displaySelectPanel(uint8_t slice) {
+	const uint8_t panel = (DISPLAY_FLIP_COLUMNS && slice < DISPLAY_PANELS) ? DISPLAY_PANELS - 1 - slice : slice;
+	for (uint8_t i = 0; i < DISPLAY_PANELS; ++i) {
+		BIT_ASSIGN(PORTB, panelChipSelectPins[i], panel != i && panel != DISPLAY_PANELS);
+	}
+}
+#else
+static inline void displaySelectPanel(__attribute__((unused)) uint8_t panel) {}
+static inline void displayMarkColumns(__attribute__((unused)) uint8_t first, __attribute__((unused)) uint8_t last) {}
+#endif
+
 /** Carry out a display hardware initialization, including a hardware reset. */
 void displaySetup() {
 	spiSetup();
-	DDRB |= BIT(DATA_CMD_PIN) | BIT(RESET_PIN);
+	DDRB |= BIT(DISPLAY_DATA_CMD_PIN) | BIT(DISPLAY_RESET_PIN);
+#if DISPLAY_PANELS > 1
+	for (uint8_t i = 0; i < DISPLAY_PANELS; ++i) {
+		BIT_SET(DDRB, panelChipSelectPins[i]);
+	}
+#endif
 	displayReset();
-	displaySendCommand(SH1106_SET_DISPLAY_OFF);
-	displaySetStartLine(0);
-	displaySetContrast(DISPLAY_DEFAULT_CONTRAST);
-	displaySendCommand(SH1106_NORMAL_DISPLAY);
+	/* The reset line is shared, all panels are configured at once */
+	displaySelectPanel(DISPLAY_PANELS);
+	displayBackendInit();
 	displayClearBuffer();
+#if DISPLAY_PANELS > 1
+	/* The display RAM content is undefined after the reset, force the transfer of the empty panels */
+	panelsDirty = BIT(DISPLAY_PANELS) - 1;
+#endif
 	displayUpdate();
-	displaySendCommand(SH1106_SET_DISPLAY_ON);
+	displaySelectPanel(DISPLAY_PANELS);
+	displayBackendSetPower(true);
+}
+
+void displaySetContrast(uint8_t contrast) {
+	displaySelectPanel(DISPLAY_PANELS);
+	displayBackendSetContrast(contrast);
+}
+
+void displaySetInverted(bool inverted) {
+	displaySelectPanel(DISPLAY_PANELS);
+	displayBackendSetInverted(inverted);
+}
+
+void displaySetStartLine(uint8_t line) {
+	displaySelectPanel(DISPLAY_PANELS);
+	displayBackendSetStartLine(line);
 }
 
-static uint64_t frameBuffer[DISPLAY_WIDTH]; /*One 64 bit value represents a vertical line of the display */
+static uint64_t frameBuffer[DISPLAY_COLUMNS]; /*One 64 bit value represents a vertical line of the display */
+
+/* Gray levels are emulated by temporal dithering: every flush advances the phase and a primitive
+ * drawn with level L is only rasterized while L > phase, i.e. in L out of (DISPLAY_GRAY_LEVELS - 1) frames.
+ * As the scene is redrawn each frame anyway, no additional bit planes are needed. */
+static uint8_t grayLevel = DISPLAY_GRAY_WHITE;
+static uint8_t grayPhase;
+static bool grayVisible = true;
 
 uint64_t* displayFrameBuffer() {
 	return frameBuffer;
 }
 
 void displayClearBuffer() {
-	for (uint8_t i = 0; i < DISPLAY_WIDTH; ++i) {
+	for (uint16_t i = 0; i < DISPLAY_COLUMNS; ++i) {
 		frameBuffer[i] = 0;
 	}
+#if DISPLAY_PANELS > 1
+	/* A panel which stayed empty doesn't change */
+	panelsDirty |= panelsDrawn;
+	panelsDrawn = 0;
+#endif
 }
 
 void displayUpdate() {
-	/* The display memory is organized in pages. For the SH1106 there exist 8 pages.
-		Each page has a size of 132x8 pixel. In total there are 8 pages stacked
-		on top of each other, realizing 64 pixel display height.
-		A column represents an 8 pixel vertical slice of a page. */
-
-	/* The SSD1306 additionally supports a vertical addressing mode,
-	 which should give a small performance advantage,
-	 unfortunately it is unavailable on the SH1106 (the clone we are using). */
-	displaySetAddressingMode(SH1106_ADDRESSING_MODE_PAGE);
-
-	for (uint8_t page = 0; page < DISPLAY_PAGES; ++page) {
-		displaySelectPageAndStartColumn(page, DISPLAY_NONVISIBLE_BORDER_OFFSET);
-
-		displaySetDataIndicator();
-		uint8_t* firstPageColumnPtr = ((uint8_t*)frameBuffer) + page;
-		for (uint8_t i = 0; i < DISPLAY_WIDTH; ++i) {
-			const uint8_t pageColumn = *(firstPageColumnPtr + DISPLAY_PAGES * i);
-			spiTransferByte(pageColumn);
+#if DISPLAY_PANELS > 1
+	for (uint8_t panel = 0; panel < DISPLAY_PANELS; ++panel) {
+		if (BIT_IS_SET(panelsDirty, panel)) {
+			displaySelectPanel(panel);
+			displayBackendFlush(&frameBuffer[panel * DISPLAY_PANEL_WIDTH]);
 		}
 	}
+#else
+	displayBackendFlush(frameBuffer);
+#endif
+
+	displayEndFrame();
 }
 
-void displayDrawVerticalLine(uint8_t x, uint8_t y, uint8_t length) {
-	if (x >= DISPLAY_WIDTH) {
+void displayEndFrame() {
+#if DISPLAY_PANELS > 1
+	/* The frame is complete, i.e. every change was part of one of its transfers */
+	panelsDirty = 0;
+#endif
+	if (++grayPhase >= DISPLAY_GRAY_LEVELS - 1) {
+		grayPhase = 0;
+	}
+	grayVisible = grayLevel > grayPhase;
+}
+
+void displayUpdateRegion(uint8_t firstPage, uint8_t lastPage, uint8_t firstColumn, uint8_t lastColumn) {
+	const uint8_t firstPanel = firstColumn / DISPLAY_PANEL_WIDTH;
+	const uint8_t lastPanel = lastColumn / DISPLAY_PANEL_WIDTH;
+
+	for (uint8_t panel = firstPanel; panel <= lastPanel; ++panel) {
+		const uint8_t panelStart = panel * DISPLAY_PANEL_WIDTH;
+		const uint8_t first = (panel == firstPanel) ? firstColumn - panelStart : 0;
+		const uint8_t last = (panel == lastPanel) ? lastColumn - panelStart : DISPLAY_PANEL_WIDTH - 1;
+
+#if DISPLAY_PANELS > 1
+		if (!BIT_IS_SET(panelsDirty, panel)) {
+			continue;
+		}
+#endif
+		displaySelectPanel(panel);
+		displayBackendFlushRegion(&frameBuffer[panelStart], firstPage, lastPage, first, last);
+	}
+}
+
+void displayUpdateRows(uint8_t firstRow, uint8_t lastRow) {
+	if (DISPLAY_Y_OUTSIDE(firstRow)) {
+		return;
+	}
+	if (DISPLAY_Y_OUTSIDE(lastRow)) {
+		lastRow = DISPLAY_HEIGHT - 1;
+	}
+#if DISPLAY_TRANSPOSED
+	/* A logical row is a framebuffer column */
+	displayUpdateRegion(0, DISPLAY_PAGES - 1, firstRow, lastRow);
+#else
+	displayUpdateRegion(firstRow / DISPLAY_BITS_PER_PAGE_COLUMN, lastRow / DISPLAY_BITS_PER_PAGE_COLUMN, 0, DISPLAY_COLUMNS - 1);
+#endif
+}
+
+void displaySetGray(uint8_t level) {
+	grayLevel = level;
+	grayVisible = level > grayPhase;
+}
+
+/** @return a column mask with `length` bits set, starting at bit row. Bits beyond the framebuffer height are clipped. */
+static inline uint64_t displayColumnMask(uint8_t row, uint8_t length) {
+	if (row >= DISPLAY_ROWS) {
+		return 0;
+	}
+	if (length >= DISPLAY_ROWS - row) {
+		return ~0ull << row;
+	}
+	return ((1ull << length) - 1) << row; /* (2 ^ length) -1 */
+}
+
+/** OR the given mask into `count` consecutive framebuffer columns, clipped to the framebuffer width. */
+static inline void displayFillColumns(uint8_t column, uint8_t count, uint64_t mask) {
+	if (DISPLAY_COLUMN_OUTSIDE(column) || mask == 0) {
+		return;
+	}
+	if (count > DISPLAY_COLUMNS - column) {
+		count = DISPLAY_COLUMNS - column;
+	}
+	if (count == 0) {
+		return;
+	}
+	displayMarkColumns(column, column + count - 1);
+	uint64_t* columnPtr = &frameBuffer[column];
+	while (count--) {
+		*columnPtr++ |= mask;
+	}
+}
+
+/* The rasterizer works in logical coordinates. Orientations which swap the axes are resolved here at
+ * compile time: a logical row is then a framebuffer column and a logical column a framebuffer bit.
+ * All mirroring is done by the display controller (see displaybackend.h). */
+#if DISPLAY_TRANSPOSED
+#define DISPLAY_FB_COLUMN(x, y) (y)
+#define DISPLAY_FB_ROW(x, y) (x)
+#else
+#define DISPLAY_FB_COLUMN(x, y) (x)
+#define DISPLAY_FB_ROW(x, y) (y)
+#endif
+
+/** Fill a w x h box at the logical position x, y. Either axis is clipped by the framebuffer helpers. */
+static inline void displayFillBox(uint8_t x, uint8_t y, uint8_t w, uint8_t h) {
+#if DISPLAY_TRANSPOSED
+	displayFillColumns(y, h, displayColumnMask(x, w));
+#else
+	displayFillColumns(x, w, displayColumnMask(y, h));
+#endif
+}
+
+/** Set a single pixel. Only the affected byte is touched, which avoids a costly 64 bit shift on the AVR. */
+static inline void displaySetPixel(uint8_t x, uint8_t y) {
+	const uint8_t row = DISPLAY_FB_ROW(x, y);
+	displayMarkColumns(DISPLAY_FB_COLUMN(x, y), DISPLAY_FB_COLUMN(x, y));
+	((uint8_t*)&frameBuffer[DISPLAY_FB_COLUMN(x, y)])[row / DISPLAY_BITS_PER_PAGE_COLUMN] |= 1 << (row % DISPLAY_BITS_PER_PAGE_COLUMN);
+}
+
+/** Same as displayDrawPixel(), but accepts coordinates outside of the display (which are discarded). */
+static inline void displayDrawPixelClipped(int16_t x, int16_t y) {
+	if (x < 0 || x >= DISPLAY_WIDTH || y < 0 || y >= DISPLAY_HEIGHT) {
 		return;
 	}
-	const uint64_t val = (1ull << length) - 1; /* (2 ^ length) -1 */
+	displaySetPixel(x, y);
+}
 
-	frameBuffer[x] |= val << y;
+void displayDrawVerticalLine(uint8_t x, uint8_t y, uint8_t length) {
+	if (!grayVisible) {
+		return;
+	}
+	displayFillBox(x, y, 1, length);
 }
 
 void displayDrawHorizontalLine(uint8_t x, uint8_t y, uint8_t length) {
-	const uint64_t val = 1ull << y;
+	if (!grayVisible) {
+		return;
+	}
+	displayFillBox(x, y, length, 1);
+}
 
-	for (uint8_t i = x; i < x + length && i < DISPLAY_WIDTH; ++i) {
-		frameBuffer[i] |= val;
+void displayDrawRowMask(uint8_t y, uint64_t mask) {
+	if (!grayVisible || DISPLAY_Y_OUTSIDE(y)) {
+		return;
 	}
+#if DISPLAY_TRANSPOSED
+	if (mask != 0) {
+		displayMarkColumns(y, y);
+		frameBuffer[y] |= mask;
+	}
+#else
+	for (uint8_t x = 0; mask != 0 && !DISPLAY_X_OUTSIDE(x); ++x, mask >>= 1) {
+		if (mask & 1) {
+			displaySetPixel(x, y);
+		}
+	}
+#endif
+}
+
+void displayDrawPixel(uint8_t x, uint8_t y) {
+	if (!grayVisible) {
+		return;
+	}
+	displayDrawPixelClipped(x, y);
+}
+
+bool displayGetPixel(uint8_t x, uint8_t y) {
+	if (DISPLAY_X_OUTSIDE(x) || DISPLAY_Y_OUTSIDE(y)) {
+		return false;
+	}
+	return (frameBuffer[DISPLAY_FB_COLUMN(x, y)] >> DISPLAY_FB_ROW(x, y)) & 1;
 }
 
 void displayDrawLine(uint8_t x1, uint8_t y1, uint8_t x2, uint8_t y2) {
-	const int8_t xDelta = x2 - x1;
-	const int8_t xSign = signInt8(xDelta);
-	const int8_t yDelta = y2 - y1;
-	const int8_t ySign = signInt8(yDelta);
-
-	const bool horizontalDrawingMode = absInt8(xDelta) > absInt8(yDelta);
-
-	if (horizontalDrawingMode) {
-		for (uint8_t y = y1, x = x1; x < DISPLAY_WIDTH; x += xSign) {
-			const int8_t yOffset = ((x - x1) * yDelta) / xDelta;
-			y = y1 + yOffset;
-			frameBuffer[x] |= 1ull << (y);
-			if (x == x2) {
-				break;
-			}
+	if (!grayVisible) {
+		return;
+	}
+	/* Bresenham: the error term tracks the distance to the ideal line, so no division is needed.
+	 * Pixels outside of the display are skipped, the line is still traced to its end point. */
+	const int16_t dx = (x2 > x1) ? x2 - x1 : x1 - x2;
+	const int16_t dy = (y2 > y1) ? y1 - y2 : y2 - y1; /* negative */
+	const int8_t xStep = (x1 < x2) ? 1 : -1;
+	const int8_t yStep = (y1 < y2) ? 1 : -1;
+	int16_t err = dx + dy;
+
+	for (uint8_t x = x1, y = y1;;) {
+		displayDrawPixelClipped(x, y);
+		if (x == x2 && y == y2) {
+			break;
 		}
-	} else {
-		for (uint8_t y = y1, x = x1; x < DISPLAY_WIDTH; y += ySign) {
-			const int8_t xOffset = ((y - y1) * xDelta) / yDelta;
-			x = x1 + xOffset;
-			frameBuffer[x] |= 1ull << (y);
-			if (y == y2) {
-				break;
-			}
+		const int16_t err2 = 2 * err;
+		if (err2 >= dy) {
+			err += dy;
+			x += xStep;
+		}
+		if (err2 <= dx) {
+			err += dx;
+			y += yStep;
 		}
 	}
 }
 
 void displayDrawRectangle(uint8_t x, uint8_t y, uint8_t w, uint8_t h) {
-	displayDrawVerticalLine(x, y, h);
-	displayDrawVerticalLine(x + w - 1, y, h);
-
-	const uint64_t val = (1ull << y) | (1ull << (y + h - 1));
+	if (!grayVisible || w == 0 || h == 0) {
+		return;
+	}
+	/* The far edges can lie beyond the uint8_t range, they must not wrap around to the other side */
+	const int16_t right = (int16_t)x + w - 1;
+	const int16_t bottom = (int16_t)y + h - 1;
 
-	for (uint8_t i = x; i < x + w && i < DISPLAY_WIDTH; ++i) {
-		frameBuffer[i] |= val;
+	displayFillBox(x, y, 1, h);
+	if (right < DISPLAY_WIDTH) {
+		displayFillBox(right, y, 1, h);
+	}
+	displayFillBox(x, y, w, 1);
+	if (bottom < DISPLAY_HEIGHT) {
+		displayFillBox(x, bottom, w, 1);
 	}
 }
 
 void displayDrawFilledRectangle(uint8_t x, uint8_t y, uint8_t w, uint8_t h) {
-	for (uint8_t i = x; i < x + w && i < DISPLAY_WIDTH; ++i) {
-		displayDrawVerticalLine(i, y, h);
+	if (!grayVisible) {
+		return;
 	}
+	displayFillBox(x, y, w, h);
 }
 
-void displayDrawPixel(uint8_t x, uint8_t y) {
-	frameBuffer[x] |= 1ull << y;
+/** Draw a vertical span from y1 to y2 (inclusive) in column x, clipped to the display. */
+static inline void displayDrawSpanClipped(int16_t x, int16_t y1, int16_t y2) {
+	if (x < 0 || x >= DISPLAY_WIDTH || y2 < 0 || y1 >= DISPLAY_HEIGHT) {
+		return;
+	}
+	if (y1 < 0) {
+		y1 = 0;
+	}
+	if (y2 >= DISPLAY_HEIGHT) {
+		y2 = DISPLAY_HEIGHT - 1;
+	}
+	displayFillBox(x, y1, 1, y2 - y1 + 1);
+}
+
+void displayDrawCircle(uint8_t xm, uint8_t ym, uint8_t r) {
+	if (!grayVisible) {
+		return;
+	}
+	/* Midpoint circle: walk one octant and mirror it into the other seven */
+	int16_t x = r;
+	int16_t y = 0;
+	int16_t err = 1 - x;
+
+	while (x >= y) {
+		displayDrawPixelClipped(xm + x, ym + y);
+		displayDrawPixelClipped(xm + y, ym + x);
+		displayDrawPixelClipped(xm - y, ym + x);
+		displayDrawPixelClipped(xm - x, ym + y);
+		displayDrawPixelClipped(xm - x, ym - y);
+		displayDrawPixelClipped(xm - y, ym - x);
+		displayDrawPixelClipped(xm + y, ym - x);
+		displayDrawPixelClipped(xm + x, ym - y);
+
+		y++;
+		if (err < 0) {
+			err += 2 * y + 1;
+		} else {
+			x--;
+			err += 2 * (y - x) + 1;
+		}
+	}
+}
+
+void displayDrawFilledCircle(uint8_t xm, uint8_t ym, uint8_t r) {
+	if (!grayVisible) {
+		return;
+	}
+	/* Same walk as displayDrawCircle(), but every column is filled with a single vertical span */
+	int16_t x = r;
+	int16_t y = 0;
+	int16_t err = 1 - x;
+
+	while (x >= y) {
+		displayDrawSpanClipped(xm + y, ym - x, ym + x);
+		displayDrawSpanClipped(xm - y, ym - x, ym + x);
+		displayDrawSpanClipped(xm + x, ym - y, ym + y);
+		displayDrawSpanClipped(xm - x, ym - y, ym + y);
+
+		y++;
+		if (err < 0) {
+			err += 2 * y + 1;
+		} else {
+			x--;
+			err += 2 * (y - x) + 1;
+		}
+	}
+}
+
+/** OR a vertical strip of up to 8 pixels into the logical column x, the lowest bit is the upmost pixel. */
+static inline void displayDrawColumnByte(uint8_t x, int16_t y, uint8_t bits) {
+#if DISPLAY_TRANSPOSED
+	for (; bits != 0; bits >>= 1, ++y) {
+		if (bits & 1) {
+			displayDrawPixelClipped(x, y);
+		}
+	}
+#else
+	if (DISPLAY_X_OUTSIDE(x) || y >= DISPLAY_HEIGHT) {
+		return;
+	}
+	displayMarkColumns(x, x);
+	frameBuffer[x] |= (y >= 0) ? ((uint64_t)bits) << y : (uint64_t)(bits >> -y);
+#endif
 }
 
 void displayDrawBitmap(uint8_t x, uint8_t y, const Bitmap* bmp) {
+	if (!grayVisible) {
+		return;
+	}
 	const uint16_t len = bmp->height * bmp->width / bmp->dataSize;
-	uint8_t col = x;
+	uint16_t col = x;
 	uint8_t row = 0;
 	for (uint16_t i = 0; i < len && col < DISPLAY_WIDTH; ++i) {
 		const uint8_t val = pgm_read_byte(&bmp->data[i]);
-		frameBuffer[col] |= ((uint64_t)val) << (bmp->height - row - bmp->dataSize + y);
+		displayDrawColumnByte(col, bmp->height - row - bmp->dataSize + y, val);
 
 		row += (bmp->dataSize);
 		if (row >= (bmp->height)) {
@@ -275,74 +488,58 @@ void displayDrawBitmap(uint8_t x, uint8_t y, const Bitmap* bmp) {
 	}
 }
 
-void displayRenderText(uint8_t x, uint8_t y, __attribute__((unused)) const char* str) {
-	const uint8_t xStart = x;
-	const FontSpec* fontSpec = font8x8();
-
-	for (uint8_t i = 0; str[i] != '\0'; ++i) {
-		if (str[i] < fontSpec->firstChar || str[i] > fontSpec->lastChar) {
-			if (str[i] == '\n') {
-				/* Start next line */
-				x = xStart;
-				y += fontSpec->charSize;
-			} else {
-				/* Character not available - skip */
-				x += fontSpec->charSize;
+/** Draw a single 8x8 glyph. The font stores one byte per glyph column, the lowest bit is the upmost pixel. */
+static void displayDrawGlyph(uint8_t x, uint8_t y, const uint8_t* glyph) {
+#if DISPLAY_TRANSPOSED
+	/* A logical row is a framebuffer column here, so the glyph is transposed on the fly */
+	for (uint8_t row = 0; row < 8 && y + row < DISPLAY_HEIGHT; ++row) {
+		uint8_t rowBits = 0;
+		for (uint8_t col = 0; col < 8; ++col) {
+			if (pgm_read_byte(&glyph[col]) & (1 << row)) {
+				rowBits |= 1 << col;
 			}
-			continue;
 		}
-		const uint16_t charDataStartIdx = fontSpec->charSize * (str[i] - fontSpec->firstChar);
-		const uint8_t* character = &(fontSpec->data[charDataStartIdx]);
-
-		for (uint8_t j = 0; j < fontSpec->charSize && j + x < DISPLAY_WIDTH; ++j) {
-			const uint64_t charColumn = pgm_read_byte(&character[j]);
-			frameBuffer[x + j] |= charColumn << y;
+		if (x < DISPLAY_WIDTH && rowBits != 0) {
+			displayMarkColumns(y + row, y + row);
+			frameBuffer[y + row] |= ((uint64_t)rowBits) << x;
 		}
-		x += fontSpec->charSize;
 	}
+#else
+	for (uint8_t j = 0; j < 8 && j + x < DISPLAY_WIDTH; ++j) {
+		displayDrawColumnByte(x + j, y, pgm_read_byte(&glyph[j]));
+	}
+#endif
 }
 
-void displayRenderTextVertical(uint8_t x, uint8_t y, __attribute__((unused)) const char* str) {
-	const uint8_t yStart = y;
-	const FontSpec* fontSpec = font8x8vertical();
+void displayRenderText(uint8_t x, uint8_t y, const char* str) {
+	if (!grayVisible) {
+		return;
+	}
+	const FontSpec* fontSpec = font8x8();
+	/* 16 bit, so that long lines don't wrap around to the start of the display */
+	uint16_t charX = x;
+	uint16_t charY = y;
 
 	for (uint8_t i = 0; str[i] != '\0'; ++i) {
 		if (str[i] < fontSpec->firstChar || str[i] > fontSpec->lastChar) {
 			if (str[i] == '\n') {
 				/* Start next line */
-				y = yStart;
-				x -= fontSpec->charSize;
+				charX = x;
+				charY += fontSpec->charSize;
 			} else {
 				/* Character not available - skip */
-				y += fontSpec->charSize;
+				charX += fontSpec->charSize;
 			}
 			continue;
 		}
-		const uint16_t charDataStartIdx = fontSpec->charSize * (str[i] - fontSpec->firstChar);
-		const uint8_t* character = &(fontSpec->data[charDataStartIdx]);
-
-		for (uint8_t j = 0; j < fontSpec->charSize && j + x < DISPLAY_WIDTH; ++j) {
-			const uint64_t charColumn = pgm_read_byte(&character[j]);
-			frameBuffer[x + j] |= charColumn << y;
+		if (charX < DISPLAY_WIDTH && charY < DISPLAY_HEIGHT) {
+			const uint16_t charDataStartIdx = fontSpec->charSize * (str[i] - fontSpec->firstChar);
+			displayDrawGlyph(charX, charY, &(fontSpec->data[charDataStartIdx]));
 		}
-		y += fontSpec->charSize;
+		charX += fontSpec->charSize;
 	}
 }
 
-void displayPrintVertical(uint8_t x, uint8_t y, const char* format, ...) {
-	char buffer[DISPLAY_PRINT_TEXT_BUFFER_SIZE];
-
-	/* Initialize buffer with zero-length string, in case vsnprintf() fails */
-	buffer[0] = '\0';
-
-	va_list args;
-	va_start(args, format);
-	vsnprintf(buffer, DISPLAY_PRINT_TEXT_BUFFER_SIZE, format, args);
-	va_end(args);
-
-	displayRenderTextVertical(x, y, buffer);
-}
-
 void displayPrint(uint8_t x, uint8_t y, const char* format, ...) {
 	char buffer[DISPLAY_PRINT_TEXT_BUFFER_SIZE];
 
@@ -0,0 +1,165 @@
+#include "utils/disp/displaybench.h"
+
+#ifdef PROFILE_ENABLED
+
+#include <avr/pgmspace.h>
+#include <util/crc16.h>
+
+#include "utils/disp/display.h"
+#include "utils/profile.h"
+
+#ifdef DISPLAY_BENCH_REPORT
+#include <stdio.h>
+
+#include "utils/usart.h"
+#endif
+
+/* Each primitive is repeated to average out the timer resolution (at most 255 times).
+ * Drawing is idempotent, so the framebuffer is the same after every repetition. */
+#ifndef DISPLAY_BENCH_REPETITIONS
+#define DISPLAY_BENCH_REPETITIONS 8
+#endif
+
+static const uint8_t benchBitmapData[] PROGMEM = {0x3C, 0x42, 0xA5, 0x81, 0xA5, 0x99, 0x42, 0x3C};
+static const Bitmap benchBitmap = {.data = benchBitmapData, .width = 8, .height = 8, .dataSize = 8};
+
+/* The golden CRCs were generated from the framebuffer content of the reference implementation.
+ * Positions are chosen to cover unaligned and page crossing cases. The clipped cases are placed
+ * relative to the display size, so they cross the right edge in landscape and in portrait. */
+static const DisplayBenchCase benchCases[] PROGMEM = {
+	{DISPLAY_BENCH_LINE, 0, 0, 127, 63, {0x0C93, 0x53F3}},
+	{DISPLAY_BENCH_LINE, 0, 63, 127, 0, {0x9B40, 0xD0EA}},
+	{DISPLAY_BENCH_LINE, 10, 5, 20, 60, {0x6E10, 0x289F}},
+	{DISPLAY_BENCH_LINE, 5, 5, 100, 5, {0xF5A3, 0x0193}},
+	{DISPLAY_BENCH_LINE, 50, 2, 50, 60, {0xBD94, 0xBF4E}},
+	{DISPLAY_BENCH_RECTANGLE, 0, 0, 128, 63, {0x510B, 0x54ED}},
+	{DISPLAY_BENCH_RECTANGLE, 10, 10, 7, 14, {0xC02B, 0xB9EA}},
+	{DISPLAY_BENCH_RECTANGLE, DISPLAY_WIDTH - 28, DISPLAY_HEIGHT - 24, 30, 20, {0x1334, 0x9470}},
+	{DISPLAY_BENCH_FILLED_RECTANGLE, 0, 0, 128, 63, {0x6E2C, 0xC38E}},
+	{DISPLAY_BENCH_FILLED_RECTANGLE, 20, 7, 40, 17, {0x198A, 0x30E2}},
+	{DISPLAY_BENCH_FILLED_RECTANGLE, DISPLAY_WIDTH - 8, DISPLAY_HEIGHT - 14, 20, 10, {0xBCD5, 0x7E50}},
+	{DISPLAY_BENCH_CIRCLE, 64, 32, 30, 0, {0x495D, 0x37BB}},
+	{DISPLAY_BENCH_CIRCLE, 4, 60, 10, 0, {0x2441, 0xF7C6}},
+	{DISPLAY_BENCH_FILLED_CIRCLE, 64, 32, 30, 0, {0x9FBA, 0xAD92}},
+	{DISPLAY_BENCH_FILLED_CIRCLE, DISPLAY_WIDTH - 4, 3, 10, 0, {0x8628, 0x8197}},
+	{DISPLAY_BENCH_BITMAP, 10, 20, 0, 0, {0x9823, 0x3395}},
+	{DISPLAY_BENCH_BITMAP, DISPLAY_WIDTH - 4, DISPLAY_HEIGHT - 8, 0, 0, {0xC729, 0xE3E0}},
+	{DISPLAY_BENCH_TEXT, 0, 0, 0, 0, {0x1183, 0x98AC}},
+	{DISPLAY_BENCH_TEXT, DISPLAY_WIDTH - 28, DISPLAY_HEIGHT - 21, 0, 0, {0x474B, 0x12D4}},
+	{DISPLAY_BENCH_TEXT, 60, 56, 0, 0, {0x723E, 0x0FC7}},
+};
+
+#define DISPLAY_BENCH_CASES (sizeof(benchCases) / sizeof(benchCases[0]))
+
+static DisplayBenchResult benchResults[DISPLAY_BENCH_CASES];
+
+void displayBenchDraw(const DisplayBenchCase* c) {
+	switch (c->primitive) {
+		case DISPLAY_BENCH_LINE:
+			displayDrawLine(c->x, c->y, c->w, c->h);
+			break;
+		case DISPLAY_BENCH_RECTANGLE:
+			displayDrawRectangle(c->x, c->y, c->w, c->h);
+			break;
+		case DISPLAY_BENCH_FILLED_RECTANGLE:
+			displayDrawFilledRectangle(c->x, c->y, c->w, c->h);
+			break;
+		case DISPLAY_BENCH_CIRCLE:
+			displayDrawCircle(c->x, c->y, c->w);
+			break;
+		case DISPLAY_BENCH_FILLED_CIRCLE:
+			displayDrawFilledCircle(c->x, c->y, c->w);
+			break;
+		case DISPLAY_BENCH_BITMAP:
+			displayDrawBitmap(c->x, c->y, &benchBitmap);
+			break;
+		case DISPLAY_BENCH_TEXT:
+			displayRenderText(c->x, c->y, "Brick 42");
+			break;
+	}
+}
+
+static uint16_t displayBenchFrameBufferCrc() {
+	const uint8_t* fb = (const uint8_t*)displayFrameBuffer();
+	uint16_t crc = 0xFFFF;
+	for (uint16_t i = 0; i < DISPLAY_COLUMNS * DISPLAY_PAGES; ++i) {
+		crc = _crc16_update(crc, fb[i]);
+	}
+	return crc;
+}
+
+uint8_t displayBenchRun() {
+	uint8_t failed = 0;
+
+	for (uint8_t i = 0; i < DISPLAY_BENCH_CASES; ++i) {
+		DisplayBenchCase c;
+		displayBenchCase(i, &c);
+
+		displayClearBuffer();
+		const uint16_t start = profileNow();
+		for (uint8_t r = 0; r < DISPLAY_BENCH_REPETITIONS; ++r) {
+			displayBenchDraw(&c);
+		}
+		const uint16_t ticks = profileNow() - start;
+
+		DisplayBenchResult* result = &benchResults[i];
+		result->cycles = (uint32_t)ticks * PROFILE_CYCLES_PER_TICK / DISPLAY_BENCH_REPETITIONS;
+		result->crc = displayBenchFrameBufferCrc();
+		result->passed = result->crc == c.goldenCrc[DISPLAY_TRANSPOSED];
+		if (!result->passed) {
+			failed++;
+		}
+	}
+
+	displayClearBuffer();
+	return failed;
+}
+
+uint8_t displayBenchCaseCount() {
+	return DISPLAY_BENCH_CASES;
+}
+
+const DisplayBenchResult* displayBenchResults() {
+	return benchResults;
+}
+
+void displayBenchCase(uint8_t index, DisplayBenchCase* benchCase) {
+	memcpy_P(benchCase, &benchCases[index], sizeof(*benchCase));
+}
+
+void displayBenchDrawCase(uint8_t index) {
+	DisplayBenchCase c;
+	displayBenchCase(index, &c);
+	displayClearBuffer();
+	displayBenchDraw(&c);
+}
+
+#ifdef DISPLAY_BENCH_REPORT
+
+static void displayBenchReportLine(const char* line) {
+	for (; *line != '\0'; ++line) {
+		while (!usartWriteByte(*line)) {
+			/* the transmit buffer drains in the background */
+		}
+	}
+}
+
+void displayBenchReport() {
+	usartSetup(DISPLAY_BENCH_REPORT_BAUD);
+	displayBenchReportLine("case,primitive,x,y,w,h,cycles,crc,golden,passed\r\n");
+
+	for (uint8_t i = 0; i < DISPLAY_BENCH_CASES; ++i) {
+		DisplayBenchCase c;
+		displayBenchCase(i, &c);
+		const DisplayBenchResult* result = &benchResults[i];
+
+		char line[48];
+		snprintf(line, sizeof(line), "%u,%u,%u,%u,%u,%u,%u,0x%04X,0x%04X,%u\r\n", i, c.primitive, c.x, c.y, c.w, c.h,
+				 result->cycles, result->crc, c.goldenCrc[DISPLAY_TRANSPOSED], result->passed);
+		displayBenchReportLine(line);
+	}
+}
+
+#endif
+
+#endif
@@ -0,0 +1,102 @@
+#include "utils/disp/displaytelemetry.h"
+
+#ifdef TELEMETRY_ENABLED
+
+#include "utils/disp/display.h"
+#include "utils/usart.h"
+
+/* Column indices have to stay below the end of frame marker */
+#if DISPLAY_COLUMNS > 128
+#error "The telemetry stream only supports a single panel"
+#endif
+
+#define TELEMETRY_SYNC_1 0xA5
+#define TELEMETRY_SYNC_2 0x5A
+#define TELEMETRY_END_OF_FRAME 0xFF
+
+/* sync, frame number, end of frame and checksum */
+#define TELEMETRY_FRAME_OVERHEAD 5
+/* x, page mask and all pages */
+#define TELEMETRY_MAX_COLUMN_SIZE (2 + DISPLAY_PAGES)
+
+/* Instead of keeping a copy of the last frame (1 KB), only an 8 bit hash per column is stored.
+ * A hash collision hides a change until the column is refreshed, therefore every frame one
+ * column is sent regardless of its hash. */
+static uint8_t columnHashes[DISPLAY_COLUMNS];
+static uint8_t refreshColumn;
+static uint8_t frameNumber;
+static uint8_t checksum;
+
+static uint8_t displayTelemetryHashColumn(const uint8_t* pageColumns) {
+	uint8_t hash = 0;
+	for (uint8_t page = 0; page < DISPLAY_PAGES; ++page) {
+		hash = ((hash << 1) | (hash >> 7)) ^ pageColumns[page];
+	}
+	return hash;
+}
+
+static void displayTelemetryWrite(uint8_t data) {
+	checksum += data;
+	usartWriteByte(data);
+}
+
+void displayTelemetrySetup() {
+	usartSetup(TELEMETRY_BAUD);
+	for (uint8_t i = 0; i < DISPLAY_COLUMNS; ++i) {
+		columnHashes[i] = ~displayTelemetryHashColumn((const uint8_t*)&displayFrameBuffer()[i]);
+	}
+}
+
+void displayTelemetrySendFrame() {
+	uint8_t budget = usartTxFree();
+	if (budget < TELEMETRY_FRAME_OVERHEAD + TELEMETRY_MAX_COLUMN_SIZE) {
+		/* the link is saturated, skip this frame. Its number is used up, so the decoder counts it as lost */
+		frameNumber++;
+		return;
+	}
+	budget -= TELEMETRY_FRAME_OVERHEAD;
+
+	usartWriteByte(TELEMETRY_SYNC_1);
+	usartWriteByte(TELEMETRY_SYNC_2);
+	checksum = 0;
+	displayTelemetryWrite(frameNumber++);
+
+	const uint64_t* frameBuffer = displayFrameBuffer();
+
+	/* Start scanning at the refresh column, so that deferred columns don't starve at the right edge */
+	uint8_t x = refreshColumn;
+	for (uint8_t i = 0; i < DISPLAY_COLUMNS && budget >= TELEMETRY_MAX_COLUMN_SIZE; ++i) {
+		const uint8_t* pageColumns = (const uint8_t*)&frameBuffer[x];
+		const uint8_t hash = displayTelemetryHashColumn(pageColumns);
+
+		if (hash != columnHashes[x] || x == refreshColumn) {
+			columnHashes[x] = hash;
+
+			uint8_t pageMask = 0;
+			for (uint8_t page = 0; page < DISPLAY_PAGES; ++page) {
+				if (pageColumns[page]) {
+					pageMask |= 1 << page;
+				}
+			}
+			displayTelemetryWrite(x);
+			displayTelemetryWrite(pageMask);
+			budget -= 2;
+			for (uint8_t page = 0; page < DISPLAY_PAGES; ++page) {
+				if (pageColumns[page]) {
+					displayTelemetryWrite(pageColumns[page]);
+					budget--;
+				}
+			}
+		}
+
+		if (++x >= DISPLAY_COLUMNS) {
+			x = 0;
+		}
+	}
+	refreshColumn = (refreshColumn + 1) % DISPLAY_COLUMNS;
+
+	displayTelemetryWrite(TELEMETRY_END_OF_FRAME);
+	usartWriteByte(checksum);
+}
+
+#endif
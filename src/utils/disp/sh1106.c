@@ -0,0 +1,125 @@
+/**
+ * @brief SH1106 display backend
+ *
+ */
+
+#ifndef DISPLAY_BACKEND_SSD1306
+
+#include <stdbool.h>
+
+#include "utils/disp/display.h"
+#include "utils/disp/displaybackend.h"
+#include "utils/spi.h"
+
+/* Display RAM has 132 columns, while only 128 are visible. Therefore skip the first 2 non-visible columns   */
+#define DISPLAY_NONVISIBLE_BORDER_OFFSET 2
+
+typedef enum {
+	SH1106_SET_CONTRAST = 0x81,
+	SH1106_ENTIRE_DISPLAY_ON_DISABLE = 0xA4,
+	SH1106_ENTIRE_DISPLAY_ON = 0xA5,
+	SH1106_NORMAL_DISPLAY = 0xA6,
+	SH1106_REVERSE_DISPLAY = 0xA7,
+	SH1106_SET_DISPLAY_OFF = 0xAE,
+	SH1106_SET_DISPLAY_ON = 0xAF,
+
+	SH1106_SET_DISPLAY_OFFSET = 0xD3,
+	SH1106_SET_COMPINS = 0xDA,
+
+	SH1106_SETVCOMDETECT = 0xDB,
+
+	SH1106_SETDISPLAYCLOCKDIV = 0xD5,
+	SH1106_SETPRECHARGE = 0xD9,
+
+	SH1106_SET_MULTIPLEX_RATIO = 0xA8,
+
+	SH1106_SET_PAGE_COLUMN_MASK = 0x0F,
+	SH1106_SET_PAGE_COLUMN_H = 0x10,
+	SH1106_SET_PAGE_COLUMN_L = 0x00,
+	SH1106_SET_PAGE = 0xB0,
+	SH1106_SETSTARTLINE = 0x40,
+
+	SH1106_COMSCANINC = 0xC0,
+	SH1106_COMSCANDEC = 0xC8,
+
+	SH1106_SEGMENT_REMAP = 0xA0,
+
+	SH1106_CHARGEPUMP = 0x8D,
+
+	SH1106_EXTERNALVCC = 0x1,
+	SH1106_SWITCHCAPVCC = 0x2
+} DisplaySH1106Command;
+
+/** Before writing to the display RAM, the page and column need to be selected.
+ * Each page has a size of 132x8 pixel. In total there are 8 pages stacked
+ * on top of each other, realizing 64 pixel display height.
+ * A column represents an 8 pixel vertical slice of a page.
+ *
+ * @param[in] page (value between 0-7)
+ * @param[in] startColumn (value between 0-127)
+ */
+static void displaySelectPageAndStartColumn(uint8_t page, uint8_t startColumn) {
+	const uint8_t nibbleMask = 0b1111;
+	startColumn += DISPLAY_NONVISIBLE_BORDER_OFFSET;
+	displaySendCommand(SH1106_SET_PAGE | (page & nibbleMask));
+	displaySendCommand(SH1106_SET_PAGE_COLUMN_L | (startColumn & nibbleMask));
+	displaySendCommand(SH1106_SET_PAGE_COLUMN_H | ((startColumn >> 4) & nibbleMask));
+}
+
+void displayBackendInit() {
+	displaySendCommand(SH1106_SET_DISPLAY_OFF);
+	/* The 2 invisible columns are on both sides, so the column offset stays the same when remapped */
+	displaySendCommand(SH1106_SEGMENT_REMAP | DISPLAY_FLIP_COLUMNS);
+	displaySendCommand(DISPLAY_FLIP_ROWS ? SH1106_COMSCANDEC : SH1106_COMSCANINC);
+	displayBackendSetStartLine(0);
+	displayBackendSetContrast(DISPLAY_DEFAULT_CONTRAST);
+	displaySendCommand(SH1106_NORMAL_DISPLAY);
+}
+
+void displayBackendFlush(const uint64_t* frameBuffer) {
+	displayBackendFlushRegion(frameBuffer, 0, DISPLAY_PAGES - 1, 0, DISPLAY_PANEL_WIDTH - 1);
+}
+
+void displayBackendFlushRegion(const uint64_t* frameBuffer, uint8_t firstPage, uint8_t lastPage, uint8_t firstColumn, uint8_t lastColumn) {
+	/* The display memory is organized in pages. For the SH1106 there exist 8 pages.
+		Each page has a size of 132x8 pixel. In total there are 8 pages stacked
+		on top of each other, realizing 64 pixel display height.
+		A column represents an 8 pixel vertical slice of a page.
+		The SH1106 only supports page addressing, so every page needs its own address commands. */
+	const uint8_t columns = lastColumn - firstColumn + 1;
+
+	for (uint8_t page = firstPage; page <= lastPage; ++page) {
+		displaySelectPageAndStartColumn(page, firstColumn);
+
+		displaySetDataIndicator();
+		spiTransmit(((const uint8_t*)&frameBuffer[firstColumn]) + page, columns, DISPLAY_PAGES);
+	}
+}
+
+void displayBackendSetPower(bool on) {
+	displaySendCommand(on ? SH1106_SET_DISPLAY_ON : SH1106_SET_DISPLAY_OFF);
+}
+
+/** Set the display brightness/contrast. Default value ist 128.
+ *
+ * @param[in] contrast value (value range 0 - 255)
+ */
+void displayBackendSetContrast(uint8_t contrast) {
+	displaySendCommand(SH1106_SET_CONTRAST);
+	displaySendCommand(contrast);
+}
+
+void displayBackendSetInverted(bool inverted) {
+	displaySendCommand(inverted ? SH1106_REVERSE_DISPLAY : SH1106_NORMAL_DISPLAY);
+}
+
+/** By setting the start line (i.e. the upmost pixel row), the first RAM data row can be mapped to a lower pixel row
+ *
+ * @param[in] start line - the physical pixel row on which the upmost RAM data should appear on
+ */
+void displayBackendSetStartLine(uint8_t line) {
+	const uint8_t lineMask = DISPLAY_ROWS - 1;
+	displaySendCommand(SH1106_SETSTARTLINE | (line & lineMask));
+}
+
+#endif
@@ -0,0 +1,128 @@
+/**
+ * @brief SSD1306 display backend
+ *
+ * In contrast to the SH1106, the SSD1306 supports a vertical addressing mode: after each byte the
+ * page is incremented and after the last page the next column is selected. This matches the
+ * column-wise layout of the framebuffer, so a whole frame is a single linear burst without any
+ * per-page commands.
+ */
+
+#ifdef DISPLAY_BACKEND_SSD1306
+
+#include <stdbool.h>
+
+#include "utils/disp/display.h"
+#include "utils/disp/displaybackend.h"
+#include "utils/spi.h"
+
+typedef enum {
+	SSD1306_SET_CONTRAST = 0x81,
+	SSD1306_ENTIRE_DISPLAY_ON_DISABLE = 0xA4,
+	SSD1306_NORMAL_DISPLAY = 0xA6,
+	SSD1306_REVERSE_DISPLAY = 0xA7,
+	SSD1306_SET_DISPLAY_OFF = 0xAE,
+	SSD1306_SET_DISPLAY_ON = 0xAF,
+
+	SSD1306_SET_DISPLAY_OFFSET = 0xD3,
+	SSD1306_SET_COMPINS = 0xDA,
+	SSD1306_SETVCOMDETECT = 0xDB,
+	SSD1306_SETDISPLAYCLOCKDIV = 0xD5,
+	SSD1306_SETPRECHARGE = 0xD9,
+	SSD1306_SET_MULTIPLEX_RATIO = 0xA8,
+	SSD1306_SETSTARTLINE = 0x40,
+
+	SSD1306_SET_ADDRESSING_MODE = 0x20,
+	SSD1306_SET_COLUMN_ADDR = 0x21,
+	SSD1306_SET_PAGE_ADDR = 0x22,
+
+	SSD1306_COMSCANINC = 0xC0,
+	SSD1306_COMSCANDEC = 0xC8,
+	SSD1306_SEGMENT_REMAP = 0xA0,
+
+	SSD1306_CHARGEPUMP = 0x8D
+} DisplaySSD1306Command;
+
+typedef enum {
+	SSD1306_ADDRESSING_MODE_HORIZONTAL = 0b00,
+	SSD1306_ADDRESSING_MODE_VERTICAL = 0b01,
+	SSD1306_ADDRESSING_MODE_PAGE = 0b10
+} DisplaySSD1306AddressingMode;
+
+#define SSD1306_CHARGEPUMP_ENABLE 0x14
+#define SSD1306_COMPINS_ALTERNATIVE 0x12
+#define SSD1306_DEFAULT_CLOCKDIV 0x80
+#define SSD1306_DEFAULT_PRECHARGE 0xF1
+#define SSD1306_DEFAULT_VCOMDETECT 0x40
+
+/** Limit the following data transfer to the given window. The address pointer wraps within the window. */
+static void displaySetWindow(uint8_t firstPage, uint8_t lastPage, uint8_t firstColumn, uint8_t lastColumn) {
+	displaySendCommand(SSD1306_SET_COLUMN_ADDR);
+	displaySendCommand(firstColumn);
+	displaySendCommand(lastColumn);
+	displaySendCommand(SSD1306_SET_PAGE_ADDR);
+	displaySendCommand(firstPage);
+	displaySendCommand(lastPage);
+}
+
+void displayBackendInit() {
+	displaySendCommand(SSD1306_SET_DISPLAY_OFF);
+	displaySendCommand(SSD1306_SETDISPLAYCLOCKDIV);
+	displaySendCommand(SSD1306_DEFAULT_CLOCKDIV);
+	displaySendCommand(SSD1306_SET_MULTIPLEX_RATIO);
+	displaySendCommand(DISPLAY_ROWS - 1);
+	displaySendCommand(SSD1306_SET_DISPLAY_OFFSET);
+	displaySendCommand(0);
+	displayBackendSetStartLine(0);
+	/* unlike the SH1106, the SSD1306 has no charge pump enabled after reset */
+	displaySendCommand(SSD1306_CHARGEPUMP);
+	displaySendCommand(SSD1306_CHARGEPUMP_ENABLE);
+	displaySendCommand(SSD1306_SET_ADDRESSING_MODE);
+	displaySendCommand(SSD1306_ADDRESSING_MODE_VERTICAL);
+	displaySendCommand(SSD1306_SEGMENT_REMAP | DISPLAY_FLIP_COLUMNS);
+	displaySendCommand(DISPLAY_FLIP_ROWS ? SSD1306_COMSCANDEC : SSD1306_COMSCANINC);
+	displaySendCommand(SSD1306_SET_COMPINS);
+	displaySendCommand(SSD1306_COMPINS_ALTERNATIVE);
+	displayBackendSetContrast(DISPLAY_DEFAULT_CONTRAST);
+	displaySendCommand(SSD1306_SETPRECHARGE);
+	displaySendCommand(SSD1306_DEFAULT_PRECHARGE);
+	displaySendCommand(SSD1306_SETVCOMDETECT);
+	displaySendCommand(SSD1306_DEFAULT_VCOMDETECT);
+	displaySendCommand(SSD1306_ENTIRE_DISPLAY_ON_DISABLE);
+	displaySendCommand(SSD1306_NORMAL_DISPLAY);
+}
+
+void displayBackendFlush(const uint64_t* frameBuffer) {
+	displaySetWindow(0, DISPLAY_PAGES - 1, 0, DISPLAY_PANEL_WIDTH - 1);
+
+	displaySetDataIndicator();
+	spiTransmit((const uint8_t*)frameBuffer, DISPLAY_PANEL_WIDTH * DISPLAY_PAGES, 1);
+}
+
+void displayBackendFlushRegion(const uint64_t* frameBuffer, uint8_t firstPage, uint8_t lastPage, uint8_t firstColumn, uint8_t lastColumn) {
+	displaySetWindow(firstPage, lastPage, firstColumn, lastColumn);
+
+	displaySetDataIndicator();
+	for (uint8_t column = firstColumn; column <= lastColumn; ++column) {
+		spiTransmit(((const uint8_t*)&frameBuffer[column]) + firstPage, lastPage - firstPage + 1, 1);
+	}
+}
+
+void displayBackendSetPower(bool on) {
+	displaySendCommand(on ? SSD1306_SET_DISPLAY_ON : SSD1306_SET_DISPLAY_OFF);
+}
+
+void displayBackendSetContrast(uint8_t contrast) {
+	displaySendCommand(SSD1306_SET_CONTRAST);
+	displaySendCommand(contrast);
+}
+
+void displayBackendSetInverted(bool inverted) {
+	displaySendCommand(inverted ? SSD1306_REVERSE_DISPLAY : SSD1306_NORMAL_DISPLAY);
+}
+
+void displayBackendSetStartLine(uint8_t line) {
+	const uint8_t lineMask = DISPLAY_ROWS - 1;
+	displaySendCommand(SSD1306_SETSTARTLINE | (line & lineMask));
+}
+
+#endif
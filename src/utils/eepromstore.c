@@ -0,0 +1,121 @@
+#include "utils/eepromstore.h"
+
+#include <avr/eeprom.h>
+#include <avr/interrupt.h>
+#include <string.h>
+#include <util/atomic.h>
+#include <util/crc16.h>
+
+#include "bit.h"
+
+/* The ATmega32 header calls the vector EE_RDY_vect, newer parts use EE_READY_vect */
+#if !defined(EE_RDY_vect) && defined(EE_READY_vect)
+#define EE_RDY_vect EE_READY_vect
+#endif
+/* and calls the write enable bits EEPE and EEMPE */
+#if !defined(EEWE) && defined(EEPE)
+#define EEWE EEPE
+#define EEMWE EEMPE
+#endif
+
+#define EEPROM_STORE_SEQUENCE 0
+#define EEPROM_STORE_PAYLOAD 1
+#define EEPROM_STORE_CRC (EEPROM_STORE_RECORD_SIZE - 1)
+
+/* Record which is written (or was loaded), only accessed by the interrupt while a write is in progress */
+static uint8_t record[EEPROM_STORE_RECORD_SIZE];
+static uint8_t slot;
+static uint8_t sequence;
+static volatile uint8_t writePosition;
+
+/** The CRC starts at 0xFF, so neither an erased nor a zeroed slot is valid */
+static uint8_t eepromStoreCrc(const uint8_t* data) {
+	uint8_t crc = 0xFF;
+	for (uint8_t i = 0; i < EEPROM_STORE_CRC; ++i) {
+		crc = _crc8_ccitt_update(crc, data[i]);
+	}
+	return crc;
+}
+
+static inline uint16_t eepromStoreSlotAddress(uint8_t s) {
+	return (uint16_t)s * EEPROM_STORE_RECORD_SIZE;
+}
+
+static void eepromStoreReadSlot(uint8_t s) {
+	eeprom_read_block(record, (const void*)(uintptr_t)eepromStoreSlotAddress(s), EEPROM_STORE_RECORD_SIZE);
+}
+
+bool eepromStoreLoad(void* payload, uint8_t size) {
+	bool found = false;
+	uint8_t newest = 0;
+
+	for (uint8_t s = 0; s < EEPROM_STORE_SLOTS; ++s) {
+		eepromStoreReadSlot(s);
+		if (record[EEPROM_STORE_CRC] != eepromStoreCrc(record)) {
+			continue;
+		}
+		/* Sequence numbers wrap around, but the valid ones are never more than EEPROM_STORE_SLOTS apart */
+		if (!found || (int8_t)(record[EEPROM_STORE_SEQUENCE] - sequence) > 0) {
+			found = true;
+			newest = s;
+			sequence = record[EEPROM_STORE_SEQUENCE];
+		}
+	}
+
+	if (!found) {
+		/* the first write goes to slot 0 with sequence number 0 */
+		slot = EEPROM_STORE_SLOTS - 1;
+		sequence = UINT8_MAX;
+		return false;
+	}
+
+	slot = newest;
+	eepromStoreReadSlot(slot);
+	memcpy(payload, &record[EEPROM_STORE_PAYLOAD], size);
+	return true;
+}
+
+void eepromStoreWrite(const void* payload, uint8_t size) {
+	ATOMIC_BLOCK(ATOMIC_RESTORESTATE) {
+		/* An unfinished record is restarted in its slot. Until it is complete its CRC doesn't match,
+		 * so the record before stays the newest valid one. */
+		if (!eepromStoreBusy()) {
+			slot = (slot + 1) % EEPROM_STORE_SLOTS;
+			sequence++;
+		}
+		record[EEPROM_STORE_SEQUENCE] = sequence;
+		memset(&record[EEPROM_STORE_PAYLOAD], 0, EEPROM_STORE_PAYLOAD_SIZE);
+		memcpy(&record[EEPROM_STORE_PAYLOAD], payload, size);
+		record[EEPROM_STORE_CRC] = eepromStoreCrc(record);
+
+		writePosition = 0;
+		BIT_SET(EECR, EERIE);
+	}
+}
+
+bool eepromStoreBusy() {
+	return BIT_IS_SET(EECR, EERIE);
+}
+
+/* Called whenever the EEPROM is ready, i.e. the previous byte is written */
+ISR(EE_RDY_vect) {
+	uint8_t position = writePosition;
+	while (position < EEPROM_STORE_RECORD_SIZE) {
+		const uint8_t data = record[position];
+		EEAR = eepromStoreSlotAddress(slot) + position;
+		position++;
+
+		BIT_SET(EECR, EERE);
+		if (EEDR != data) {
+			EEDR = data;
+			/* EEWE has to be set within 4 cycles after EEMWE, interrupts are disabled in here */
+			BIT_SET(EECR, EEMWE);
+			BIT_SET(EECR, EEWE);
+			writePosition = position;
+			return;
+		}
+	}
+
+	writePosition = position;
+	BIT_CLR(EECR, EERIE);
+}
@@ -0,0 +1,38 @@
+#include "utils/eventqueue.h"
+
+#include <string.h>
+
+/* The element is copied with ordinary memory accesses, which the compiler could move across the
+ * volatile index update. The barrier keeps the order, the AVR itself executes in program order. */
+#define EVENT_QUEUE_BARRIER() __asm__ __volatile__("" ::: "memory")
+
+bool eventQueuePush(EventQueue* queue, const void* event) {
+	const uint8_t head = queue->head;
+	const uint8_t next = (head + 1) & queue->mask;
+	if (next == queue->tail) {
+		queue->dropped++;
+		return false;
+	}
+
+	memcpy(&queue->buffer[(uint16_t)head * queue->elementSize], event, queue->elementSize);
+	EVENT_QUEUE_BARRIER();
+	queue->head = next;
+	return true;
+}
+
+bool eventQueuePop(EventQueue* queue, void* event) {
+	const uint8_t tail = queue->tail;
+	if (tail == queue->head) {
+		return false;
+	}
+
+	EVENT_QUEUE_BARRIER();
+	memcpy(event, &queue->buffer[(uint16_t)tail * queue->elementSize], queue->elementSize);
+	EVENT_QUEUE_BARRIER();
+	queue->tail = (tail + 1) & queue->mask;
+	return true;
+}
+
+bool eventQueueIsEmpty(const EventQueue* queue) {
+	return queue->tail == queue->head;
+}
@@ -0,0 +1,83 @@
+#include "utils/frametimer.h"
+
+#include <avr/io.h>
+
+#include "bit.h"
+
+/* Newer parts (e.g. the ATmega644P) have an interrupt mask and flag register per timer */
+#if !defined(TIMSK) && defined(TIMSK1)
+#define TIMSK TIMSK1
+#define TIFR TIFR1
+#endif
+
+#define FRAME_TIMER_REMAINDER (FRAME_TIMER_TICKS_PER_SECOND % FRAME_RATE)
+/* A compare value closer than this to the counter could be passed while it is written */
+#define FRAME_TIMER_MIN_LEAD 4
+
+#if FRAME_RATE > 255
+#error "The remainder accumulator is 8 bit"
+#endif
+
+static uint8_t remainder;
+
+#ifdef PROFILE_ENABLED
+static FrameTimerStats stats;
+#endif
+
+void frameTimerSetup() {
+	/* Normal mode, prescaler 8 - the counter simply wraps around, the compare value is advanced in software */
+	TCCR1A = 0;
+	TCCR1B = BIT(CS11);
+}
+
+void frameTimerStart() {
+	remainder = 0;
+	OCR1A = TCNT1 + FRAME_TIMER_TICKS;
+	TIFR = BIT(OCF1A); /* clear a pending compare match, the flag is cleared by writing a one */
+	BIT_SET(TIMSK, OCIE1A);
+}
+
+void frameTimerStop() {
+	BIT_CLR(TIMSK, OCIE1A);
+}
+
+void frameTimerStartFrame() {
+	const uint16_t scheduled = OCR1A;
+#ifdef PROFILE_ENABLED
+	const uint16_t delay = TCNT1 - scheduled;
+#endif
+
+	uint32_t offset = FRAME_TIMER_TICKS;
+	remainder += FRAME_TIMER_REMAINDER;
+	if (remainder >= FRAME_RATE) {
+		remainder -= FRAME_RATE;
+		offset++;
+	}
+#ifdef PROFILE_ENABLED
+	stats.frames++;
+	stats.histogram[delay < FRAME_TIMER_JITTER_BUCKETS * FRAME_TIMER_JITTER_BUCKET_TICKS ? delay / FRAME_TIMER_JITTER_BUCKET_TICKS : FRAME_TIMER_JITTER_BUCKETS - 1]++;
+	if (delay > stats.maxDelay) {
+		stats.maxDelay = delay;
+	}
+#endif
+	/* If the previous frame overran, the next tick may already be over. The compare match would
+	 * then only happen after the counter wrapped around, so whole frames are skipped instead.
+	 * 32 bit, as a few frame periods exceed the 16 bit counter range at low frame rates. */
+	while ((uint16_t)(TCNT1 - scheduled) + (uint32_t)FRAME_TIMER_MIN_LEAD >= offset) {
+		offset += FRAME_TIMER_TICKS;
+#ifdef PROFILE_ENABLED
+		stats.missedFrames++;
+#endif
+	}
+	OCR1A = scheduled + (uint16_t)offset;
+}
+
+uint16_t frameTimerNow() {
+	return TCNT1;
+}
+
+#ifdef PROFILE_ENABLED
+const FrameTimerStats* frameTimerStats() {
+	return &stats;
+}
+#endif
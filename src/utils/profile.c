@@ -0,0 +1,81 @@
+#include "utils/profile.h"
+
+#ifdef PROFILE_ENABLED
+
+#include <avr/io.h>
+
+#ifdef PROFILE_REPORT
+#include <stdio.h>
+#include <util/atomic.h>
+
+#include "utils/usart.h"
+
+#ifdef TELEMETRY_ENABLED
+#error "The profile report and the telemetry stream share the USART"
+#endif
+#endif
+
+static ProfileStats stats[PROFILE_STAGE_COUNT];
+static uint16_t startTicks[PROFILE_STAGE_COUNT];
+
+void profileInit() {
+	/* Timer1 is set up by the frame timer and runs freely, durations are computed modulo 2^16 */
+	for (uint8_t i = 0; i < PROFILE_STAGE_COUNT; ++i) {
+		stats[i] = (ProfileStats){.min = UINT16_MAX};
+	}
+#ifdef PROFILE_REPORT
+	usartSetup(PROFILE_REPORT_BAUD);
+#endif
+}
+
+uint16_t profileNow() {
+	return TCNT1;
+}
+
+void profileBegin(ProfileStage stage) {
+	startTicks[stage] = TCNT1;
+}
+
+void profileEnd(ProfileStage stage) {
+	const uint16_t ticks = TCNT1 - startTicks[stage];
+	ProfileStats* s = &stats[stage];
+
+	s->last = ticks;
+	if (ticks < s->min) {
+		s->min = ticks;
+	}
+	if (ticks > s->max) {
+		s->max = ticks;
+	}
+	s->total += ticks;
+	s->count++;
+}
+
+const ProfileStats* profileStats(ProfileStage stage) {
+	return &stats[stage];
+}
+
+#ifdef PROFILE_REPORT
+void profileReport() {
+	for (uint8_t i = 0; i < PROFILE_STAGE_COUNT; ++i) {
+		/* The stages are measured in the frame interrupt */
+		ProfileStats s;
+		ATOMIC_BLOCK(ATOMIC_RESTORESTATE) {
+			s = stats[i];
+		}
+		const uint32_t average = s.count ? s.total / s.count : 0;
+
+		char line[48];
+		snprintf(line, sizeof(line), "%u,%u,%lu,%lu,%lu,%lu\r\n", i, s.count,
+				 (unsigned long)s.last * PROFILE_CYCLES_PER_TICK, (unsigned long)s.min * PROFILE_CYCLES_PER_TICK,
+				 (unsigned long)s.max * PROFILE_CYCLES_PER_TICK, (unsigned long)average * PROFILE_CYCLES_PER_TICK);
+		for (const char* c = line; *c != '\0'; ++c) {
+			while (!usartWriteByte(*c)) {
+				/* the transmit buffer drains in the background */
+			}
+		}
+	}
+}
+#endif
+
+#endif
@@ -0,0 +1,90 @@
+#include "utils/sound.h"
+
+#include <avr/io.h>
+#include <avr/pgmspace.h>
+#include <stddef.h>
+
+#include "bit.h"
+#include "utils/eventqueue.h"
+
+/* Newer parts (e.g. the ATmega644P) split the control register and call the compare unit A, OC2A is PD7 as well */
+#ifdef TCCR2A
+#define OCR2 OCR2A
+#define SOUND_TIMER_START() (TCCR2A = BIT(WGM21) | BIT(COM2A0), TCCR2B = BIT(CS22))
+#define SOUND_TIMER_STOP() (TCCR2B = 0, TCCR2A = 0)
+#else
+#define SOUND_TIMER_START() (TCCR2 = BIT(WGM21) | BIT(COM20) | BIT(CS22))
+#define SOUND_TIMER_STOP() (TCCR2 = 0)
+#endif
+
+#if SOUND_PRESCALER != 64
+#error "Adjust the clock select bits in SOUND_TIMER_START() to the prescaler"
+#endif
+
+/* Effects to play, soundPlay() is the producer and soundTick() the consumer */
+EVENT_QUEUE_DEFINE(queue, const SoundNote*, SOUND_QUEUE_SIZE);
+
+static const SoundNote* note; /* note which is currently played, NULL if idle */
+static uint8_t framesLeft;
+
+static inline void soundStart(uint8_t ocr) {
+	OCR2 = ocr;
+	TCNT2 = 0; /* otherwise a lower compare value is missed once and the counter wraps around */
+	/* CTC mode, toggle OC2 on compare match, prescaler 64 */
+	SOUND_TIMER_START();
+}
+
+static inline void soundSilence() {
+	/* Stop the timer and disconnect OC2, the pin falls back to the (low) port value */
+	SOUND_TIMER_STOP();
+}
+
+void soundSetup() {
+	soundSilence();
+	BIT_CLR(PORTD, PD7);
+	BIT_SET(DDRD, PD7);
+}
+
+void soundPlay(const SoundNote* effect) {
+	eventQueuePush(&queue, &effect);
+}
+
+void soundTick() {
+	/* The common case between note changes */
+	if (framesLeft != 0 && --framesLeft != 0) {
+		return;
+	}
+
+	SoundNote current = SOUND_END;
+	if (note != NULL) {
+		memcpy_P(&current, ++note, sizeof(current));
+	}
+	if (current.frames == 0) {
+		/* effect finished (or idle), continue with the next queued one */
+		if (!eventQueuePop(&queue, &note)) {
+			if (note != NULL) {
+				note = NULL;
+				soundSilence();
+			}
+			return;
+		}
+		memcpy_P(&current, note, sizeof(current));
+		if (current.frames == 0) {
+			/* empty effect */
+			note = NULL;
+			soundSilence();
+			return;
+		}
+	}
+
+	framesLeft = current.frames;
+	if (current.ocr == SOUND_REST) {
+		soundSilence();
+	} else {
+		soundStart(current.ocr);
+	}
+}
+
+bool soundBusy() {
+	return note != NULL || !eventQueueIsEmpty(&queue);
+}
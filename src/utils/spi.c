@@ -20,3 +20,17 @@ uint8_t spiTransferByte(uint8_t data) {
 	while (!(BIT_IS_SET(SPSR, SPIF)));
 	return SPDR;
 }
+
+void spiTransmit(const uint8_t* data, uint16_t count, uint8_t stride) {
+	if (count == 0) {
+		return;
+	}
+	SPDR = *data;
+	while (--count) {
+		data += stride;
+		const uint8_t next = *data;
+		while (!(BIT_IS_SET(SPSR, SPIF)));
+		SPDR = next;
+	}
+	while (!(BIT_IS_SET(SPSR, SPIF)));
+}
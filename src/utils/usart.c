@@ -0,0 +1,77 @@
+#include "utils/usart.h"
+
+/* Only the telemetry stream and the reports send, the buffer and the interrupt would waste SRAM and flash otherwise */
+#if defined(TELEMETRY_ENABLED) || defined(DISPLAY_BENCH_REPORT) || defined(PROFILE_REPORT)
+
+#include <avr/interrupt.h>
+#include <avr/io.h>
+
+#include "bit.h"
+
+/* Newer parts (e.g. the ATmega644P) number their USARTs, and UCSRC has an address of its own */
+#if !defined(UDR) && defined(UDR0)
+#define UBRRH UBRR0H
+#define UBRRL UBRR0L
+#define UCSRA UCSR0A
+#define UCSRB UCSR0B
+#define UCSRC UCSR0C
+#define UDR UDR0
+#define U2X U2X0
+#define UCSZ1 UCSZ01
+#define UCSZ0 UCSZ00
+#define TXEN TXEN0
+#define UDRIE UDRIE0
+#define USART_UDRE_vect USART0_UDRE_vect
+#define USART_UCSRC_SELECT 0
+#else
+/* URSEL selects UCSRC, which shares its address with UBRRH */
+#define USART_UCSRC_SELECT BIT(URSEL)
+#endif
+
+#define USART_TX_BUFFER_MASK (USART_TX_BUFFER_SIZE - 1)
+
+static uint8_t txBuffer[USART_TX_BUFFER_SIZE];
+/* head is only written by the producer, tail only by the interrupt. Single byte accesses are atomic on the AVR. */
+static volatile uint8_t txHead;
+static volatile uint8_t txTail;
+
+void usartSetup(uint32_t baud) {
+	const uint16_t ubrr = (F_CPU / 8 + baud / 2) / baud - 1; /* rounded, double speed mode */
+
+	UBRRH = (uint8_t)(ubrr >> 8);
+	UBRRL = (uint8_t)ubrr;
+	BIT_SET(UCSRA, U2X);
+	/* 8 data bits, no parity, 1 stop bit */
+	UCSRC = USART_UCSRC_SELECT | BIT(UCSZ1) | BIT(UCSZ0);
+	UCSRB = BIT(TXEN);
+}
+
+bool usartWriteByte(uint8_t data) {
+	const uint8_t head = txHead;
+	const uint8_t next = (head + 1) & USART_TX_BUFFER_MASK;
+	if (next == txTail) {
+		return false;
+	}
+	txBuffer[head] = data;
+	txHead = next;
+
+	/* (Re-)enable the data register empty interrupt, it disables itself once the buffer ran empty */
+	BIT_SET(UCSRB, UDRIE);
+	return true;
+}
+
+uint8_t usartTxFree() {
+	return (txTail - txHead - 1) & USART_TX_BUFFER_MASK;
+}
+
+ISR(USART_UDRE_vect) {
+	const uint8_t tail = txTail;
+	if (tail == txHead) {
+		BIT_CLR(UCSRB, UDRIE);
+		return;
+	}
+	UDR = txBuffer[tail];
+	txTail = (tail + 1) & USART_TX_BUFFER_MASK;
+}
+
+#endif
@@ -0,0 +1,140 @@
+#!/usr/bin/env python3
+"""Decode a captured framebuffer telemetry stream (see include/utils/disp/displaytelemetry.h).
+
+Capture the stream with any serial terminal in raw mode, e.g.
+    stty -F /dev/ttyUSB0 115200 raw && cat /dev/ttyUSB0 > capture.bin
+and convert it with
+    tools/telemetry_decode.py capture.bin game.gif
+
+The stream contains the physical framebuffer. For builds with DISPLAY_ORIENTATION 90 or 270
+pass --portrait to get the picture in the logical (transposed) layout.
+The GIF is played at 60 frames per second, pass --rate HZ for builds with another FRAME_RATE.
+Frames which the firmware skipped because the link was saturated are counted as lost.
+
+If Pillow is installed an animated GIF is written, otherwise the output name is used
+as prefix for a sequence of PBM images.
+"""
+
+import sys
+
+WIDTH = 128
+HEIGHT = 64
+PAGES = HEIGHT // 8
+SYNC = b"\xa5\x5a"
+END_OF_FRAME = 0xFF
+DEFAULT_FRAME_RATE = 60
+
+
+def parse_frame(data, pos):
+    """Parse a frame starting after the sync bytes.
+    Returns (frame number, changed columns, position after the frame) or None if the frame is corrupt."""
+    start = pos
+    if pos >= len(data):
+        return None
+    frame_number = data[pos]
+    pos += 1
+    changes = {}
+    while pos < len(data) and data[pos] != END_OF_FRAME:
+        x = data[pos]
+        if x >= WIDTH or pos + 1 >= len(data):
+            return None
+        page_mask = data[pos + 1]
+        pos += 2
+        pages = [0] * PAGES
+        for page in range(PAGES):
+            if page_mask & (1 << page):
+                if pos >= len(data):
+                    return None
+                pages[page] = data[pos]
+                pos += 1
+        changes[x] = pages
+    if pos + 1 >= len(data):
+        return None
+    checksum = sum(data[start:pos + 1]) & 0xFF
+    if checksum != data[pos + 1]:
+        return None
+    return frame_number, changes, pos + 2
+
+
+def decode(data):
+    columns = [[0] * PAGES for _ in range(WIDTH)]
+    frames = []
+    lost = 0
+    last_number = None
+    pos = 0
+    while True:
+        pos = data.find(SYNC, pos)
+        if pos < 0:
+            break
+        result = parse_frame(data, pos + len(SYNC))
+        if result is None:
+            pos += 1
+            continue
+        frame_number, changes, pos = result
+        if last_number is not None:
+            lost += (frame_number - last_number - 1) & 0xFF
+        last_number = frame_number
+        for x, pages in changes.items():
+            columns[x] = pages
+        frames.append([list(c) for c in columns])
+    return frames, lost
+
+
+def pixel(frame, x, y):
+    return (frame[x][y // 8] >> (y % 8)) & 1
+
+
+def logical_pixel(frame, x, y, portrait):
+    return pixel(frame, y, x) if portrait else pixel(frame, x, y)
+
+
+def write_pbm(frame, path, width, height, portrait):
+    with open(path, "w") as f:
+        f.write("P1\n%d %d\n" % (width, height))
+        for y in range(height):
+            f.write(" ".join(str(logical_pixel(frame, x, y, portrait)) for x in range(width)) + "\n")
+
+
+def main():
+    args = sys.argv[1:]
+    portrait = "--portrait" in args
+    if portrait:
+        args.remove("--portrait")
+    frame_rate = DEFAULT_FRAME_RATE
+    if "--rate" in args:
+        i = args.index("--rate")
+        try:
+            frame_rate = int(args[i + 1])
+        except (IndexError, ValueError):
+            print(__doc__)
+            return 1
+        del args[i:i + 2]
+    if len(args) != 2 or frame_rate <= 0:
+        print(__doc__)
+        return 1
+    width, height = (HEIGHT, WIDTH) if portrait else (WIDTH, HEIGHT)
+    with open(args[0], "rb") as f:
+        data = f.read()
+    frames, lost = decode(data)
+    print("%d frames decoded, %d frames lost" % (len(frames), lost))
+    if not frames:
+        return 1
+
+    try:
+        from PIL import Image
+    except ImportError:
+        for i, frame in enumerate(frames):
+            write_pbm(frame, "%s%05d.pbm" % (args[1], i), width, height, portrait)
+        return 0
+
+    images = []
+    for frame in frames:
+        image = Image.new("1", (width, height))
+        image.putdata([logical_pixel(frame, x, y, portrait) * 255 for y in range(height) for x in range(width)])
+        images.append(image)
+    images[0].save(args[1], save_all=True, append_images=images[1:], duration=1000 // frame_rate, loop=0)
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())